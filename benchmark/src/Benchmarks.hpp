@@ -0,0 +1,25 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+/*==============================================================================
+  Benchmarks of the primitives of the engine. Each group runs over the same
+  corpus: the positions of the bench command (see diagnostics::Bench).
+  ==============================================================================*/
+
+#include <memory>
+#include <vector>
+
+#include "Harness.hpp"
+#include "MaeBoard.hpp"
+
+namespace benchmark
+{
+typedef std::vector<std::unique_ptr<game_rules::MaeBoard>> Corpus;
+
+void run_board_benchmarks (Harness& harness, Corpus& corpus);
+void run_engine_benchmarks (Harness& harness, Corpus& corpus);
+void run_util_benchmarks (Harness& harness);
+
+} // namespace benchmark
+
+#endif // BENCHMARKS_H
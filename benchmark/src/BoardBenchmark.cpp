@@ -0,0 +1,78 @@
+#include "Benchmarks.hpp"
+#include "MoveGenerator.hpp"
+
+namespace benchmark
+{
+using std::vector;
+
+using game_rules::IBoard;
+using game_rules::MaeBoard;
+using game_rules::Move;
+using game_rules::BoardSquare;
+
+using game_engine::MoveGenerator;
+
+void
+run_board_benchmarks (Harness& harness, Corpus& corpus)
+{
+   // The legal moves of every position, so that each of them is made and
+   // undone without any failure in between
+   vector<vector<Move>> legal_moves (corpus.size ());
+   ullong moves_count = 0;
+
+   MoveGenerator generator;
+   for (uint i = 0; i < corpus.size (); ++i)
+   {
+      vector<Move> moves;
+      generator.generate_moves (corpus[i].get (), moves);
+
+      for (uint j = 0; j < moves.size (); ++j)
+         if (corpus[i]->make_move (moves[j], true) != IBoard::KING_LEFT_IN_CHECK)
+         {
+            corpus[i]->undo_move ();
+            legal_moves[i].push_back (moves[j]);
+         }
+
+      moves_count += legal_moves[i].size ();
+   }
+
+   harness.run ("make_move + undo_move", moves_count, [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+      {
+         MaeBoard* board = corpus[i].get ();
+         for (uint j = 0; j < legal_moves[i].size (); ++j)
+         {
+            board->make_move (legal_moves[i][j], true);
+            board->undo_move ();
+         }
+      }
+   });
+
+   harness.run ("attacks_to", corpus.size () * game_rules::BOARD_SQUARES_COUNT, [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+         for (uint square = 0; square < game_rules::BOARD_SQUARES_COUNT; ++square)
+            keep (corpus[i]->attacks_to ((BoardSquare) square, true));
+   });
+
+   // The board keeps the checkers of its position once worked out, so the
+   // position is set up again before each call; the cost of doing only that
+   // is given apart, to be taken off
+   vector<game_rules::BoardState> states;
+   for (uint i = 0; i < corpus.size (); ++i)
+      states.push_back (corpus[i]->get_state ());
+
+   harness.run ("set_state", corpus.size (), [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+         corpus[i]->set_state (states[i]);
+   });
+
+   harness.run ("set_state + is_king_in_check", corpus.size (), [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+      {
+         corpus[i]->set_state (states[i]);
+         keep (corpus[i]->is_king_in_check ());
+      }
+   });
+}
+
+} // namespace benchmark
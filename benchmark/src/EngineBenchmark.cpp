@@ -0,0 +1,37 @@
+#include "Benchmarks.hpp"
+#include "MoveGenerator.hpp"
+#include "PositionEvaluator.hpp"
+
+namespace benchmark
+{
+using std::vector;
+
+using game_rules::Move;
+
+using game_engine::MoveGenerator;
+using game_engine::PositionEvaluator;
+
+void
+run_engine_benchmarks (Harness& harness, Corpus& corpus)
+{
+   MoveGenerator generator;
+   vector<Move> moves;
+
+   harness.run ("generate_moves", corpus.size (), [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+      {
+         moves.clear ();
+         generator.generate_moves (corpus[i].get (), moves);
+         keep (moves.size ());
+      }
+   });
+
+   PositionEvaluator evaluator;
+
+   harness.run ("static_evaluation", corpus.size (), [&] () {
+      for (uint i = 0; i < corpus.size (); ++i)
+         keep (evaluator.static_evaluation (corpus[i].get ()));
+   });
+}
+
+} // namespace benchmark
@@ -0,0 +1,74 @@
+#include "Harness.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace benchmark
+{
+using std::string;
+using std::vector;
+using std::endl;
+using std::setw;
+
+Harness::Harness (std::ostream& out) : out (out)
+{
+   this->out << std::left << setw (28) << "benchmark" << std::right
+             << setw (12) << "calls"
+             << setw (10) << "min ns"
+             << setw (10) << "p50 ns"
+             << setw (10) << "p90 ns"
+             << setw (10) << "p99 ns"
+             << setw (10) << "cycles" << endl;
+}
+
+/*==============================================================================
+  Write a line with the statistics of SAMPLES, each of them CALLS calls long
+  ==============================================================================*/
+void
+Harness::report (const string& name, ullong calls, vector<Sample>& samples)
+{
+   std::sort (samples.begin (), samples.end (),
+              [] (const Sample& a, const Sample& b) { return a.ns < b.ns; });
+
+   auto per_call = [&samples, calls] (double percentile) -> double {
+      return samples[(uint) (percentile * (samples.size () - 1))].ns / calls;
+   };
+
+   Result result;
+   result.name = name;
+   result.calls = calls;
+   result.min_ns = per_call (0.0);
+   result.p50_ns = per_call (0.5);
+   result.p90_ns = per_call (0.9);
+   result.p99_ns = per_call (0.99);
+   result.cycles = samples[(samples.size () - 1) / 2].cycles / calls;
+
+   this->out << std::left << setw (28) << result.name << std::right
+             << std::fixed << std::setprecision (2)
+             << setw (12) << result.calls
+             << setw (10) << result.min_ns
+             << setw (10) << result.p50_ns
+             << setw (10) << result.p90_ns
+             << setw (10) << result.p99_ns;
+
+   if (HARNESS_HAS_CYCLE_COUNTER)
+      this->out << setw (10) << result.cycles << endl;
+   else
+      this->out << setw (10) << "-" << endl;
+}
+
+/*==============================================================================
+  Return the time stamp counter, which on current processors ticks at a
+  constant rate (that of the nominal frequency) whatever the actual clock
+  ==============================================================================*/
+ullong
+Harness::read_cycles ()
+{
+#if HARNESS_HAS_CYCLE_COUNTER
+   return __rdtsc ();
+#else
+   return 0;
+#endif
+}
+
+} // namespace benchmark
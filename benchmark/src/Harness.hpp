@@ -0,0 +1,127 @@
+#ifndef HARNESS_H
+#define HARNESS_H
+
+/*==============================================================================
+  A small harness to time the primitives of the engine in isolation.
+
+  The body of a benchmark performs CALLS calls to the primitive being
+  measured. The harness first finds how many times the body must run for a
+  sample to take SAMPLE_TIME, warms up the caches and the branch predictors
+  running it for a while, and then takes SAMPLES samples. It reports the
+  minimum and some percentiles of the time per call, and the cycles per call
+  at the median (counted with the time stamp counter where there is one).
+  ==============================================================================*/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <ostream>
+
+#include "Util.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HARNESS_HAS_CYCLE_COUNTER 1
+#else
+#define HARNESS_HAS_CYCLE_COUNTER 0
+#endif
+
+namespace benchmark
+{
+/*------------------------------------------------------------------------------
+  Keep the compiler from optimizing away a computation whose VALUE is never
+  used
+  ----------------------------------------------------------------------------*/
+template <typename T>
+inline void
+keep (const T& value)
+{
+   asm volatile ("" : : "g" (value) : "memory");
+}
+
+class Harness
+{
+  public:
+   static const uint SAMPLES = 200;
+   static constexpr double SAMPLE_TIME_US = 100.0;
+   static constexpr double WARMUP_TIME_MS = 100.0;
+
+   struct Result
+   {
+      std::string name;
+      ullong calls;          // Per sample
+      double min_ns;         // Time per call
+      double p50_ns;
+      double p90_ns;
+      double p99_ns;
+      double cycles;         // Per call, at the median (0 if unknown)
+   };
+
+   explicit Harness (std::ostream& out);
+
+   template <typename Body>
+   void run (const std::string& name, ullong calls, Body body);
+
+  private:
+   typedef std::chrono::steady_clock Clock;
+
+   struct Sample
+   {
+      double ns;
+      double cycles;
+   };
+
+   template <typename Body>
+   Sample take_sample (ullong repetitions, Body& body);
+
+   void report (const std::string& name, ullong calls, std::vector<Sample>& samples);
+
+   static ullong read_cycles ();
+
+   std::ostream& out;
+};
+
+template <typename Body>
+Harness::Sample
+Harness::take_sample (ullong repetitions, Body& body)
+{
+   Clock::time_point start = Clock::now ();
+   ullong start_cycles = read_cycles ();
+
+   for (ullong i = 0; i < repetitions; ++i)
+      body ();
+
+   ullong cycles = read_cycles () - start_cycles;
+   std::chrono::duration<double, std::nano> elapsed = Clock::now () - start;
+
+   Sample sample = { elapsed.count (), (double) cycles };
+   return sample;
+}
+
+/*==============================================================================
+  Time BODY, which makes CALLS calls to the primitive named NAME
+  ==============================================================================*/
+template <typename Body>
+void
+Harness::run (const std::string& name, ullong calls, Body body)
+{
+   // Double the repetitions until a sample is long enough to be measured
+   ullong repetitions = 1;
+   while (take_sample (repetitions, body).ns < SAMPLE_TIME_US * 1000)
+      repetitions *= 2;
+
+   Clock::time_point warmup_start = Clock::now ();
+   while (std::chrono::duration<double, std::milli> (Clock::now () - warmup_start).count ()
+          < WARMUP_TIME_MS)
+      take_sample (repetitions, body);
+
+   std::vector<Sample> samples;
+   for (uint i = 0; i < SAMPLES; ++i)
+      samples.push_back (take_sample (repetitions, body));
+
+   report (name, calls * repetitions, samples);
+}
+
+} // namespace benchmark
+
+#endif // HARNESS_H
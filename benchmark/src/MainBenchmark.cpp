@@ -0,0 +1,31 @@
+#include <iostream>
+
+#include "Benchmarks.hpp"
+#include "Bench.hpp"
+
+using game_rules::MaeBoard;
+
+using diagnostics::Bench;
+
+using benchmark::Harness;
+using benchmark::Corpus;
+
+int
+main ()
+{
+   Corpus corpus;
+
+   for (uint i = 0; Bench::POSITIONS[i] != nullptr; ++i)
+   {
+      corpus.push_back (std::unique_ptr<MaeBoard> (new MaeBoard ()));
+      corpus.back ()->load_fen (Bench::POSITIONS[i]);
+   }
+
+   Harness harness (std::cout);
+
+   benchmark::run_board_benchmarks (harness, corpus);
+   benchmark::run_engine_benchmarks (harness, corpus);
+   benchmark::run_util_benchmarks (harness);
+
+   return 0;
+}
@@ -0,0 +1,37 @@
+#include "Benchmarks.hpp"
+
+namespace benchmark
+{
+using std::vector;
+
+using util::Util;
+using util::bitboard;
+
+void
+run_util_benchmarks (Harness& harness)
+{
+   // Sparse and dense bitboards alike, none of them empty
+   const uint BITBOARDS_COUNT = 1024;
+   vector<bitboard> bitboards;
+
+   ullong seed = 8;
+   while (bitboards.size () < BITBOARDS_COUNT)
+   {
+      // SplitMix64
+      ullong z = (seed += 0x9E3779B97F4A7C15ULL);
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      z ^= z >> 31;
+
+      bitboard value = (bitboards.size () % 2 == 0 ? z : z & (z >> 13) & (z >> 29));
+      if (value != 0)
+         bitboards.push_back (value);
+   }
+
+   harness.run ("MSB_position", BITBOARDS_COUNT, [&] () {
+      for (uint i = 0; i < BITBOARDS_COUNT; ++i)
+         keep (Util::MSB_position (bitboards[i]));
+   });
+}
+
+} // namespace benchmark
@@ -4,12 +4,16 @@
   tables, iterative deepening search, null-window search, etc.)
   ==============================================================================*/
 
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 #include "AlphaBetaSearch.hpp"
 #include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
 #include "TranspositionTable.hpp"
 #include "BoardKey.hpp"
+#include "Profiler.hpp"
+#include "PerfCounters.hpp"
+#include "SearchTreeLog.hpp"
+#include "Logger.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -17,20 +21,33 @@
 #include <cstdlib>
 #include <cassert>
 #include <cmath>
+#include <memory>
 
 namespace game_engine
 {
 using std::vector;
 using game_rules::Move;
 using game_rules::IBoard;
+using game_rules::MaeBoard;
+using game_rules::Piece;
 
 AlphaBetaSearch::AlphaBetaSearch (
-    IPositionEvaluator* position_evaluator, MoveGenerator* move_generator)
+    PositionEvaluator* position_evaluator, MoveGenerator* move_generator)
 {
    this->board = nullptr;
    this->move_generator = move_generator;
    this->position_evaluator = position_evaluator;
    this->transposition_table = new TranspositionTable (64);
+
+   this->is_searching = false;
+   this->target_depth = 0;
+   this->completed_depth = 0;
+   this->is_infinite = false;
+   this->stop_requested = false;
+   this->node_limit = 0;
+   this->time_limit = 0;
+   this->mate_limit = 0;
+   this->multi_pv = 1;
 }
 
 AlphaBetaSearch::~AlphaBetaSearch ()
@@ -38,63 +55,94 @@ AlphaBetaSearch::~AlphaBetaSearch ()
    delete this->transposition_table;
 }
 
+/*==============================================================================
+  Write the statistics of the last search as a JSON line to the statistics
+  output, if there is one.
+  ==============================================================================*/
 void
-AlphaBetaSearch::print_statistics (vector<Move>& principal_variation)
+AlphaBetaSearch::print_statistics (const vector<Move>& principal_variation)
 {
-   if (this->n_internal_nodes)
-   {
-      this->average_branching_factor =
-            (uint)
-            ((double)(this->average_branching_factor / this->n_internal_nodes) + 0.5);
-   }
-
-   std::cerr << "Evaluation: " << this->root_value << std::endl;
-   std::cerr << "Average branching factor: "
-             << this->average_branching_factor << std::endl;
-   std::cerr << "Leaf nodes: " << this->n_leaf_nodes << std::endl;
-   std::cerr << "Nodes evaluated: " << this->n_nodes_evaluated << std::endl;
-   std::cerr << "Hash table hits: " << this->hash_table_hits << std::endl;
+   if (this->statistics_output == nullptr)
+      return;
 
-   std::cerr << "Principal variation: " << std::endl;
+   vector<std::string> notation;
    for (uint i = 0; i < principal_variation.size (); ++i)
-      std::cerr << principal_variation[i] << std::endl;
+      notation.push_back (principal_variation[i].get_notation ());
+
+   this->statistics.write_json (*this->statistics_output, this->root_value, notation);
 }
 
 void
 AlphaBetaSearch::reset_statistics ()
 {
-   this->n_nodes_evaluated = 0;
-   this->n_internal_nodes = 0;
-   this->n_leaf_nodes = 0;
-   this->average_branching_factor = 0;
-   this->hash_table_hits = 0;
+   this->statistics.reset ();
 }
 
 /*==============================================================================
   Return in BEST_MOVE the most promising move that can be made in the current
-  BOARD, doing a search of DEPTH levels.
+  BOARD, searching as deep as LIMITS allow.
 
   Possible results are: NORMAL_EVALUATION, WHITE_MATES, BLACK_MATES,
   STALEMATE, DRAW_BY_REPETITION.
   ==============================================================================*/
 IEngine::GameResult
-AlphaBetaSearch::get_best_move (uint depth, IBoard* board, Move& best_move)
+AlphaBetaSearch::get_best_move (const SearchLimits& limits, IBoard* board, Move& best_move)
 {
    GameResult winner[game_rules::PLAYERS_COUNT][game_rules::PLAYERS_COUNT] = {
       { GameResult::WHITE_MATES, GameResult::BLACK_MATES },
       { GameResult::BLACK_MATES, GameResult::WHITE_MATES }
    };
 
-   if (board == 0)
+   // The search only runs on a MaeBoard, which it calls directly
+   MaeBoard* mae_board = dynamic_cast<MaeBoard*> (board);
+   if (mae_board == nullptr)
       return IEngine::ERROR;
 
-   this->board = board;
+   uint depth = (limits.depth > 0 ? limits.depth : MAX_SEARCH_DEPTH);
+
+   // A mate in N moves is seen within 2N plies: N moves of the winner, and
+   // the replies of the loser, the last of which finds that there is none
+   if (limits.mate > 0)
+      depth = std::min (depth, 2 * limits.mate);
+
+   {
+      std::lock_guard<std::mutex> lock (this->control_mutex);
+      this->is_searching = true;
+      this->target_depth = depth;
+
+      // Never turns an infinite search (e.g. a ponder search) into a normal one
+      if (limits.infinite)
+         this->is_infinite = true;
+   }
+
+   if (!limits.infinite)
+   {
+      this->node_limit = limits.nodes;
+      this->time_limit = limits.get_move_time (board->get_player_in_turn ());
+      this->mate_limit = limits.mate;
+   }
+
+   this->board = mae_board;
    this->max_depth = depth;
+   this->search_start = std::chrono::steady_clock::now ();
 
-   vector<Move> principal_variation;
-   this->root_value = iterative_deepening (principal_variation);
+   reset_statistics ();
+
+   // The counters belong to the thread that opens them, i.e. this one
+   std::unique_ptr<diagnostics::PerfCounters> counters;
+   if (this->count_hardware_events)
+   {
+      counters.reset (new diagnostics::PerfCounters ());
+      counters->start ();
+   }
+
+   this->root_value = iterative_deepening (this->principal_variation);
 
-   if (abs (this->root_value) == abs(MATE_VALUE))
+   if (counters)
+      this->statistics.hardware = counters->stop ();
+   print_statistics (this->principal_variation);
+
+   if (is_mate_score (this->root_value))
       this->result = winner[root_value > 0 ? 0 : 1][board->get_player_in_turn ()];
 
    else if (root_value == DRAW_VALUE && result == STALEMATE)
@@ -105,14 +153,310 @@ AlphaBetaSearch::get_best_move (uint depth, IBoard* board, Move& best_move)
 
    // If we are not using transposition tables, we cannot reconstruct the
    // principal variation
-   if (principal_variation.size () > 0)
-      best_move = principal_variation[0];
+   if (this->principal_variation.size () > 0)
+      best_move = this->principal_variation[0];
    else
-      best_move = this->best_move;
+      best_move = this->root_best_move;
+
+   finish_search ();
 
    return this->result;
 }
 
+void
+AlphaBetaSearch::get_principal_variation (vector<Move>& principal_variation) const
+{
+   principal_variation = this->principal_variation;
+}
+
+void
+AlphaBetaSearch::set_multi_pv (uint lines)
+{
+   this->multi_pv = (lines > 0 ? lines : 1);
+}
+
+/*==============================================================================
+  Return in LINES the best lines found by the last search (as many as
+  requested by set_multi_pv, if there were enough legal moves), best first.
+  ==============================================================================*/
+void
+AlphaBetaSearch::get_lines (vector<Line>& lines) const
+{
+   lines.clear ();
+   for (uint i = 0; i < this->root_lines.size (); ++i)
+   {
+      Line line;
+      line.is_mate = is_mate_score (this->root_lines[i].value);
+      line.score = get_reported_score (this->root_lines[i].value);
+      line.principal_variation = this->root_lines[i].principal_variation;
+      lines.push_back (line);
+   }
+}
+
+/*==============================================================================
+  Convert VALUE, in the engine units, into the score shown to the user: the
+  number of moves to the mate for mate scores, and centipawns for the rest
+  ==============================================================================*/
+int
+AlphaBetaSearch::get_reported_score (int value) const
+{
+   if (is_mate_score (value))
+      return get_mate_distance (value);
+
+   return to_centipawns (value);
+}
+
+/*==============================================================================
+  Convert VALUE, in the engine units, into centipawns. Evolved weights may
+  leave material without any weight, and then VALUE is returned as it is.
+  ==============================================================================*/
+int
+AlphaBetaSearch::to_centipawns (int value) const
+{
+   int material_weight = this->position_evaluator->get_material_weight ();
+
+   return (material_weight != 0 ? value / material_weight : value);
+}
+
+/*==============================================================================
+  Mate scores are stored in the transposition table as distances from the
+  node being stored, not from the root, so that they remain right when the
+  same position is found at a different PLY
+  ==============================================================================*/
+int
+AlphaBetaSearch::to_table_score (int value, uint ply)
+{
+   if (value <= MATE_VALUE + MAX_MATE_PLY)
+      return value - ply;
+   if (value >= -MATE_VALUE - MAX_MATE_PLY)
+      return value + ply;
+
+   return value;
+}
+
+int
+AlphaBetaSearch::from_table_score (int value, uint ply)
+{
+   if (value <= MATE_VALUE + MAX_MATE_PLY)
+      return value + ply;
+   if (value >= -MATE_VALUE - MAX_MATE_PLY)
+      return value - ply;
+
+   return value;
+}
+
+/*==============================================================================
+  Mark the next search as started. This is called by the thread controlling
+  the search before the search itself is started in another thread, so that a
+  stop () issued right after starting it is never lost.
+  ==============================================================================*/
+void
+AlphaBetaSearch::prepare_search ()
+{
+   std::lock_guard<std::mutex> lock (this->control_mutex);
+
+   this->is_searching = true;
+   this->is_infinite = false;
+   this->stop_requested = false;
+   this->completed_depth = 0;
+}
+
+/*==============================================================================
+  Prepare the next search to be an infinite search, i.e. a search that does
+  not stop at its given depth, but keeps deepening until stop () is called.
+  ==============================================================================*/
+void
+AlphaBetaSearch::start_infinite_search ()
+{
+   std::lock_guard<std::mutex> lock (this->control_mutex);
+
+   this->is_searching = true;
+   this->is_infinite = true;
+   this->stop_requested = false;
+   this->completed_depth = 0;
+   this->target_depth = MAX_SEARCH_DEPTH;
+}
+
+/*==============================================================================
+  Prepare the next search to be a ponder search, an infinite search that
+  ponder_hit () turns into a normal one.
+  ==============================================================================*/
+void
+AlphaBetaSearch::start_pondering ()
+{
+   start_infinite_search ();
+}
+
+/*==============================================================================
+  The move we were pondering on was actually played, so turn the ponder search
+  into a normal one, keeping all the work done so far. If the search has
+  already gone past its depth, stop it right away.
+  ==============================================================================*/
+void
+AlphaBetaSearch::ponder_hit ()
+{
+   std::lock_guard<std::mutex> lock (this->control_mutex);
+
+   this->is_infinite = false;
+   if (this->is_searching && this->completed_depth >= this->target_depth)
+      this->stop_requested = true;
+}
+
+/*==============================================================================
+  Abort the current search as soon as possible. The search still returns the
+  best move found in the last iteration it completed.
+  ==============================================================================*/
+void
+AlphaBetaSearch::stop ()
+{
+   std::lock_guard<std::mutex> lock (this->control_mutex);
+
+   if (this->is_searching)
+      this->stop_requested = true;
+}
+
+void
+AlphaBetaSearch::finish_search ()
+{
+   std::lock_guard<std::mutex> lock (this->control_mutex);
+
+   this->is_searching = false;
+   this->is_infinite = false;
+   this->stop_requested = false;
+   this->node_limit = 0;
+   this->time_limit = 0;
+   this->mate_limit = 0;
+   this->search_moves.clear ();
+}
+
+void
+AlphaBetaSearch::set_search_moves (const vector<Move>& moves)
+{
+   this->search_moves = moves;
+}
+
+void
+AlphaBetaSearch::get_root_moves (vector<RootMoveStatistics>& root_moves) const
+{
+   root_moves.clear ();
+   for (uint i = 0; i < this->root_moves.size (); ++i)
+   {
+      RootMoveStatistics statistics;
+      statistics.move = this->root_moves[i].move;
+      statistics.score = to_centipawns (this->root_moves[i].score);
+      statistics.nodes = this->root_moves[i].nodes;
+      statistics.total_nodes = this->root_moves[i].total_nodes;
+      root_moves.push_back (statistics);
+   }
+}
+
+/*==============================================================================
+  Replace the transposition table by an empty one using the largest of the
+  possible sizes (see TranspositionTable::possible_size) that fits in
+  MEGABYTES, or the smallest one if none does.
+  ==============================================================================*/
+void
+AlphaBetaSearch::set_hash_size (uint megabytes)
+{
+   ushort size = TranspositionTable::possible_size.begin ()->first;
+   for (auto entry : TranspositionTable::possible_size)
+      if (entry.first <= megabytes)
+         size = entry.first;
+
+   delete this->transposition_table;
+   this->transposition_table = new TranspositionTable (size);
+}
+
+/*==============================================================================
+  Ask the search to stop if it went past its node or time limits
+  ==============================================================================*/
+void
+AlphaBetaSearch::check_search_limits ()
+{
+   if (this->node_limit != 0 && this->statistics.nodes >= this->node_limit)
+      this->stop_requested = true;
+
+   else if (this->time_limit != 0 &&
+            (this->statistics.nodes & TIME_CHECK_INTERVAL) == 0 &&
+            get_elapsed_time () >= this->time_limit)
+   {
+      this->stop_requested = true;
+   }
+}
+
+/*==============================================================================
+  Return the milliseconds passed since the current search started
+  ==============================================================================*/
+double
+AlphaBetaSearch::get_elapsed_time () const
+{
+   std::chrono::duration<double, std::milli> elapsed =
+         std::chrono::steady_clock::now () - this->search_start;
+
+   return elapsed.count ();
+}
+
+/*==============================================================================
+  Return TRUE if the search has been asked to stop. The first iteration is
+  always completed, so that there is a move to return.
+  ==============================================================================*/
+bool
+AlphaBetaSearch::is_search_stopped () const
+{
+   return (this->stop_requested.load (std::memory_order_relaxed) &&
+           this->completed_depth.load (std::memory_order_relaxed) > 0);
+}
+
+/*==============================================================================
+  Send the search observer, if any, the current state of the search: the
+  SCORE (in the engine units) of the PRINCIPAL_VARIATION found at DEPTH, which
+  is the LINE-th best one (starting at 1).
+  ==============================================================================*/
+void
+AlphaBetaSearch::report_progress (
+    uint depth, uint line, int score, const vector<Move>& principal_variation)
+{
+   if (this->search_observer == nullptr)
+      return;
+
+   uint capacity = this->transposition_table->get_capacity ();
+   ullong hashfull = capacity ? (ullong) this->transposition_table->get_size () * 1000 / capacity : 0;
+
+   SearchReport report;
+   report.depth = depth;
+   report.line = line;
+   report.is_mate = is_mate_score (score);
+   report.score = get_reported_score (score);
+   report.elapsed_ms = get_elapsed_time ();
+   report.nodes = this->statistics.nodes;
+   report.hashfull = hashfull < 1000 ? hashfull : 1000;
+   report.principal_variation = principal_variation;
+
+   this->search_observer->on_search_report (report);
+}
+
+/*==============================================================================
+  A new best MOVE with the given SCORE was found at the root, in the middle of
+  an iteration. If it is not the best move of the last iteration, let the
+  observer know about it right away, since the iteration may still take long
+  to finish.
+  ==============================================================================*/
+void
+AlphaBetaSearch::report_root_move (int score, const Move& move)
+{
+   // Only the first line of a MultiPV search is reported this way
+   if (this->search_observer == nullptr || this->completed_depth == 0 ||
+       !this->excluded_root_moves.empty () || move == this->root_best_move)
+   {
+      return;
+   }
+
+   vector<Move> principal_variation;
+   build_line (move, principal_variation);
+
+   report_progress (this->max_depth, 1, score, principal_variation);
+}
+
 /*==========================================================================
   Perform an iterative deepening search using THIS->BOARD as the root
   node. Include Aspiration Search within the main loop to increase the
@@ -120,55 +464,323 @@ AlphaBetaSearch::get_best_move (uint depth, IBoard* board, Move& best_move)
   where a re-search is needed (i.e. the value returned by alpha-beta
   outside the alpha-beta windows)
 
+  In MultiPV mode, every iteration searches the root once per line, each time
+  excluding the root moves of the lines already found, so the K best moves
+  get exact scores while sharing the transposition table.
+
+  The root moves are generated once, and every iteration tries them in the
+  order left by the previous one (see RootMoveList::sort).
+
   Return the minimax value of THIS->BOARD and the principal variation in
   PRINCIPAL_VARIATION.
   ==========================================================================*/
 int
 AlphaBetaSearch::iterative_deepening (vector<Move>& principal_variation)
 {
+   PROFILE_ZONE ("iterative_deepening");
+
    uint search_window_size = pow(2, 6);
-   int alpha, beta;
 
    // This estimation of the negamax value may be really wrong if we are in
    // the middle of a tactical sequence
    this->root_value = this->position_evaluator->static_evaluation (board);
+   this->best_move = Move ();
+   this->root_best_move = Move ();
+   this->completed_depth = 0;
+   this->root_lines.clear ();
+   this->excluded_root_moves.clear ();
+
+   // Start with the best move of a previous search of this position, if any
+   TranspositionTable::BoardEntry entry;
+   BoardKey key = this->board->get_hash_key ();
+   this->root_moves.generate (this->board, this->move_generator, this->search_moves);
+   if (this->transposition_table->get_entry (key, entry))
+      this->root_moves.promote (entry.best_move);
+
+   uint lines_count = std::min (this->multi_pv, this->root_moves.size ());
+   if (lines_count == 0)
+      lines_count = 1;
 
-   for (uint depth = 1; depth <= this->max_depth; ++depth)
+   // An infinite search keeps deepening past the target depth until told
+   // otherwise (see ponder_hit and stop)
+   for (uint depth = 1;
+        depth <= this->target_depth || (this->is_infinite && depth <= MAX_SEARCH_DEPTH);
+        ++depth)
    {
+      PROFILE_ZONE ("iteration");
+
+      int previous_root_value = this->root_value;
+      GameResult root_result = NORMAL_EVALUATION;
+      vector<RootLine> lines;
+
       this->max_depth = depth;
+      this->statistics.start_iteration (depth);
+      this->root_moves.start_iteration ();
 
-      // Search for the right negamax value by using reduced alpha-beta windows
-      while (1)
+      for (uint i = 0; i < lines_count; ++i)
       {
-         reset_statistics ();
+         int expected_value = (i < this->root_lines.size () ?
+                               this->root_lines[i].value : previous_root_value);
 
-         // Close window around the likely real value of the root node.
-         alpha = root_value - search_window_size;
-         beta = root_value + search_window_size;
+         int value = aspiration_search (expected_value, search_window_size);
+         if (is_search_stopped ())
+            break;
 
-         this->root_value = alpha_beta (0, alpha, beta);
+         // Later lines must not hide a draw or a stalemate at the root
+         if (i == 0)
+            root_result = this->result;
 
-         if (abs (this->root_value) == abs(MATE_VALUE))
-            break;
+         // There is no line at all in a finished game
+         RootLine line;
+         line.value = value;
+         if (!this->best_move.is_null ())
+            build_line (this->best_move, line.principal_variation);
+         lines.push_back (line);
+
+         this->excluded_root_moves.push_back (this->best_move);
+      }
+      this->excluded_root_moves.clear ();
+      this->statistics.finish_iteration ();
+
+      // The result of an interrupted iteration cannot be trusted
+      if (is_search_stopped ())
+      {
+         this->root_value = previous_root_value;
+         break;
+      }
+
+      std::stable_sort (lines.begin (), lines.end (),
+                        [] (const RootLine& a, const RootLine& b) { return a.value > b.value; });
+
+      vector<Move> best_moves;
+      for (uint i = 0; i < lines.size (); ++i)
+         if (!lines[i].principal_variation.empty ())
+            best_moves.push_back (lines[i].principal_variation[0]);
+      this->root_moves.sort (best_moves);
+
+      this->root_lines = lines;
+      this->result = root_result;
+      this->root_value = lines[0].value;
+      this->root_best_move = (lines[0].principal_variation.empty () ?
+                              Move () : lines[0].principal_variation[0]);
+      this->completed_depth = depth;
+
+      principal_variation = lines[0].principal_variation;
+
+      for (uint i = 0; i < lines.size (); ++i)
+         report_progress (depth, i + 1, lines[i].value, lines[i].principal_variation);
+
+      // The next iteration would hardly finish in the time left
+      if (this->time_limit != 0 && !this->is_infinite &&
+          get_elapsed_time () >= this->time_limit / 2.0)
+      {
+         break;
+      }
+
+      // A mate as short as the one asked for has been found
+      if (this->mate_limit != 0 && !this->is_infinite && is_mate_score (this->root_value) &&
+          get_mate_distance (this->root_value) > 0 &&
+          (uint) get_mate_distance (this->root_value) <= this->mate_limit)
+      {
+         break;
+      }
+   }
+
+   return root_value;
+}
+
+/*==============================================================================
+  Search the root for the right negamax value by using reduced alpha-beta
+  windows of SEARCH_WINDOW_SIZE around EXPECTED_VALUE, widening them as
+  needed. The window size found to work is kept for the next search.
+  ==============================================================================*/
+int
+AlphaBetaSearch::aspiration_search (int expected_value, uint& search_window_size)
+{
+   int value = expected_value;
+   int alpha = MATE_VALUE, beta = -MATE_VALUE;
+
+   // Mate scores are too far from the rest for a window around them to help
+   if (!is_mate_score (value))
+   {
+      alpha = value - search_window_size;
+      beta = value + search_window_size;
+   }
+
+   while (1)
+   {
+      value = root_search (alpha, beta);
+
+      if (is_search_stopped ())
+         break;
+
+      if (value > alpha && value < beta)
+      {
+         search_window_size /= 2;
+         break;
+      }
+
+      // Nothing lies outside the full window
+      if (alpha <= MATE_VALUE && beta >= -MATE_VALUE)
+         break;
+
+      search_window_size *= 2;
+      this->statistics.count_re_search ();
+
+      // Close window around the likely real value of the root node, unless
+      // it has grown as large as the full one
+      if (is_mate_score (value) || search_window_size >= (uint) -MATE_VALUE)
+      {
+         alpha = MATE_VALUE;
+         beta = -MATE_VALUE;
+      }
+      else
+      {
+         alpha = util::Util::max (value - (int) search_window_size, MATE_VALUE);
+         beta = util::Util::min (value + (int) search_window_size, -MATE_VALUE);
+      }
+   }
+
+   return value;
+}
+
+/*==============================================================================
+  Build in PRINCIPAL_VARIATION the line starting with ROOT_MOVE, taking the
+  rest of it from the table entries of the subtree just searched
+  ==============================================================================*/
+void
+AlphaBetaSearch::build_line (const Move& root_move, vector<Move>& principal_variation)
+{
+   Move move = root_move;
+
+   principal_variation.clear ();
+   principal_variation.push_back (move);
+
+   if (this->board->make_move (move, /* is_computer_move: */ true) == IBoard::NO_ERROR)
+   {
+      build_principal_variation (this->board, principal_variation);
+      this->board->undo_move ();
+   }
+}
+
+/*==============================================================================
+  Search the root node, like alpha_beta does with the interior ones, but
+  trying the moves of THIS->ROOT_MOVES in their order and recording the score
+  and the size of the subtree of each one there. The root entry of the
+  transposition table is only used to order the moves of the first iteration
+  (see iterative_deepening), never to cut the search short.
+
+  Return the minimax value of THIS->BOARD and its best move in THIS->BEST_MOVE.
+  ==============================================================================*/
+int
+AlphaBetaSearch::root_search (int alpha, int beta)
+{
+   int best_value = MATE_VALUE;
+   uint best_value_index = 0;
+   uint n_moves_made = 0;
+   GameResult root_result = NORMAL_EVALUATION;
+
+   if (this->tree_log != nullptr)
+      this->tree_log->enter (0, SearchTreeLog::ROOT, alpha, beta, this->statistics.nodes);
+
+   this->statistics.count_node (0);
+   check_search_limits ();
+
+   // The root entry holds the value of all the root moves, which is not
+   // the value searched for when some of them are excluded
+   bool is_excluding = !this->excluded_root_moves.empty ();
+
+   for (uint i = 0; i < this->root_moves.size (); ++i)
+   {
+      Move move = this->root_moves[i].move;
+
+      if (is_excluding &&
+          find (this->excluded_root_moves.begin (), this->excluded_root_moves.end (), move) !=
+          this->excluded_root_moves.end ())
+      {
+         continue;
+      }
+
+      ullong start_nodes = this->statistics.nodes;
+      int tentative_value;
+
+      // Root moves are known to be legal
+      IBoard::Error error = this->board->make_move (move, /* is_computer_move: */ true);
+      n_moves_made++;
 
-         if (this->root_value > alpha && this->root_value < beta)
+      if (error == IBoard::DRAW_BY_REPETITION)
+         tentative_value = DRAW_VALUE;
+      else
+      {
+         tentative_value = -alpha_beta (1, -beta, -util::Util::max (alpha, best_value));
+
+         if (this->tree_log != nullptr)
+            this->tree_log->leave (1, move, -tentative_value, this->statistics.nodes);
+      }
+
+      this->board->undo_move ();
+
+      if (is_search_stopped ())
+         return 0;
+
+      this->root_moves.record (i, tentative_value, this->statistics.nodes - start_nodes);
+
+      if (tentative_value > best_value)
+      {
+         root_result = (error == IBoard::DRAW_BY_REPETITION ? DRAW_BY_REPETITION : NORMAL_EVALUATION);
+         best_value = tentative_value;
+         best_value_index = i;
+
+         // A value failing high is only a lower bound, and the re-search of
+         // the aspiration window reports the exact one
+         if (best_value > alpha && best_value < beta)
+            report_root_move (best_value, move);
+
+         if (best_value >= beta) // Alpha-beta cutoff
          {
-            search_window_size /= 2;
+            this->statistics.count_beta_cutoff (n_moves_made - 1);
+            if (this->tree_log != nullptr)
+               this->tree_log->set_cutoff (0, n_moves_made - 1);
             break;
          }
-         search_window_size *= 2;
       }
    }
 
-   principal_variation.clear ();
-   build_principal_variation (board, principal_variation);
+   this->statistics.moves_made += n_moves_made;
 
-   // Ensure that the code still works even if transposition tables are
-   // removed
-   if (principal_variation.size () == 0)
-      principal_variation.push_back (best_move);
+   // There are no legal moves in a finished game
+   if (n_moves_made == 0)
+   {
+      this->best_move = Move ();
+      this->result = NORMAL_EVALUATION;
+      if (this->board->is_king_in_check ())
+         return MATE_VALUE;
 
-   return root_value;
+      this->result = STALEMATE;
+      return DRAW_VALUE;
+   }
+
+   if (!is_excluding)
+   {
+      BoardKey key = this->board->get_hash_key ();
+      TranspositionTable::flag accuracy =
+            best_value >= beta ? TranspositionTable::UPPER_BOUND :
+            best_value > alpha ? TranspositionTable::EXACT :
+            TranspositionTable::LOWER_BOUND;
+
+      this->transposition_table->add_entry (
+          key, to_table_score (best_value, 0), accuracy,
+          this->root_moves[best_value_index].move, this->max_depth);
+   }
+
+   this->result = root_result;
+   this->best_move = this->root_moves[best_value_index].move;
+   this->statistics.internal_nodes++;
+
+   if (this->tree_log != nullptr)
+      this->tree_log->leave (0, Move (), best_value, this->statistics.nodes);
+
+   return best_value;
 }
 
 /*==============================================================================
@@ -183,22 +795,43 @@ AlphaBetaSearch::iterative_deepening (vector<Move>& principal_variation)
 int
 AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
 {
+   PROFILE_ZONE ("alpha_beta");
+
    vector<Move> moves;
    ushort best_value_index = 0;
    int tentative_value;
    int best_value = MATE_VALUE; // Initially the best_value you can do is lose the game!
 
+   if (is_search_stopped ())
+      return 0;
+
+   if (this->tree_log != nullptr)
+      this->tree_log->enter (depth, SearchTreeLog::ALPHA_BETA, alpha, beta, this->statistics.nodes);
+
    this->result = GameResult::NORMAL_EVALUATION;
+   this->statistics.count_node (depth);
+   check_search_limits ();
+
+   // Mate distance pruning: no line from here can be better than mating at
+   // the next ply, nor worse than being mated right now, so once a mate
+   // closer to the root is known the window may become empty
+   alpha = util::Util::max (alpha, MATE_VALUE + (int) depth);
+   beta = util::Util::min (beta, -MATE_VALUE - (int) depth - 1);
+   if (alpha >= beta)
+   {
+      this->statistics.leaf_nodes++;
+      return alpha;
+   }
 
    // Probe the transposition table to avoid recomputing
    bool hash_hit = false;
    TranspositionTable::BoardEntry entry;
-   BoardKey key = {
-      this->board->get_hash_key (),
-      this->board->get_hash_lock ()
-   };
+   BoardKey key = this->board->get_hash_key ();
+
    if (this->transposition_table->get_entry (key, entry))
    {
+      entry.score = from_table_score (entry.score, depth);
+
       if (entry.depth >= max_depth - depth)
          if (entry.accuracy == TranspositionTable::EXACT ||
              (entry.accuracy == TranspositionTable::UPPER_BOUND && entry.score >= beta) ||
@@ -206,36 +839,67 @@ AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
          {
             if (this->board->get_repetition_count () == 1)
             {
-               this->hash_table_hits++;
-               this->n_leaf_nodes++;
+               this->statistics.count_transposition_probe (true);
+               this->statistics.count_transposition_cutoff (entry.accuracy);
+               this->statistics.leaf_nodes++;
                this->best_move = entry.best_move;
 
+               if (this->tree_log != nullptr)
+                  this->tree_log->set_transposition (depth, SearchTreeLog::TT_CUTOFF);
+
                return entry.score;
             }
          }
       hash_hit = true;
+
+      if (this->tree_log != nullptr)
+         this->tree_log->set_transposition (depth, SearchTreeLog::TT_HIT);
    }
+   this->statistics.count_transposition_probe (hash_hit);
 
    // BASE CASE
    if (depth >= max_depth)
    {
       // Quiescence search may return a value that is well below the current
       // node evaluation, meaning that all captures considered are really bad.
-      this->n_nodes_evaluated++;
       return util::Util::max (
-          this->position_evaluator->static_evaluation (this->board),
+          this->position_evaluator->lazy_evaluation (this->board, alpha, beta),
           quiescence (0, alpha, beta));
    }
 
+   // Internal iterative deepening: the move ordering of a PV node far from
+   // the horizon matters too much to leave it to the move generator
+   bool is_pv_node = (beta - alpha > 1);
+   if (!hash_hit && is_pv_node && max_depth - depth >= IID_MIN_DEPTH)
+   {
+      uint full_depth = this->max_depth;
+      SearchTreeLog* tree_log = this->tree_log;
+
+      // The shallower search runs at the same ply as this node, so logging it
+      // would overwrite this node's entry in the tree log
+      this->tree_log = nullptr;
+      this->max_depth -= IID_REDUCTION;
+      alpha_beta (depth, alpha, beta);
+      this->max_depth = full_depth;
+      this->tree_log = tree_log;
+      this->statistics.internal_iterative_deepenings++;
+
+      if (is_search_stopped ())
+         return 0;
+
+      // The shallower search left its best move in the table
+      hash_hit = this->transposition_table->get_entry (key, entry);
+   }
+
    this->move_generator->generate_moves (this->board, moves);
    if (moves.size () == 0)
    {
       if (!this->board->is_king_in_check ())
       {
-         this->n_nodes_evaluated++;
+         this->statistics.leaf_nodes++;
          return this->position_evaluator->static_evaluation (this->board);
       }
-      return MATE_VALUE;
+      return MATE_VALUE + depth;
    }
 
    // Improve move ordering by examining the principal_variation node at this ply
@@ -268,9 +932,16 @@ AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
       {
          assert(error == IBoard::NO_ERROR);
          tentative_value = -alpha_beta (depth + 1, -beta, -util::Util::max (alpha, best_value));
+
+         if (this->tree_log != nullptr)
+            this->tree_log->leave (depth + 1, moves[i], -tentative_value, this->statistics.nodes);
       }
 
-      assert(this->board->undo_move ());
+      VERIFY (this->board->undo_move ());
+
+      // Nothing found in an interrupted search is stored in the table
+      if (is_search_stopped ())
+         return 0;
 
       if (tentative_value > best_value)
       {
@@ -281,22 +952,28 @@ AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
 
          best_value = tentative_value;
          best_value_index = i;
+
          if (best_value >= beta) // Alpha-beta cutoff
+         {
+            this->statistics.count_beta_cutoff (n_moves_made - 1);
+            if (this->tree_log != nullptr)
+               this->tree_log->set_cutoff (depth, n_moves_made - 1);
             break;
+         }
       }
    }
 
-   this->average_branching_factor += n_moves_made;
+   this->statistics.moves_made += n_moves_made;
 
    // The king must be in mate or stalemate since no move was made
    if (n_moves_made == 0)
    {
-      std::cerr << "No moves could be done" << std::endl;
+      LOG_DEBUG ("No moves could be done at ply %u", depth);
       if (this->board->is_king_in_check ())
-         best_value = MATE_VALUE;
+         best_value = MATE_VALUE + depth;
       else
       {
-         std::cerr << "Draw by stalemate" << std::endl;
+         LOG_DEBUG ("Draw by stalemate at ply %u", depth);
          this->result = STALEMATE;
          best_value = DRAW_VALUE;
       }
@@ -312,9 +989,9 @@ AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
             TranspositionTable::LOWER_BOUND;
 
       this->transposition_table->add_entry (
-          key, best_value, accuracy, moves[best_value_index], real_depth);
+          key, to_table_score (best_value, depth), accuracy, moves[best_value_index], real_depth);
       this->best_move = moves[best_value_index];
-      this->n_internal_nodes++;
+      this->statistics.internal_nodes++;
    }
 
    return best_value;
@@ -323,24 +1000,45 @@ AlphaBetaSearch::alpha_beta (uint depth, int alpha, int beta)
 /*============================================================================
   Perform a quiescence search taking into account only lines of captures.
 
+  Captures that cannot raise alpha even when winning the captured piece for
+  free (plus DELTA_PRUNING_MARGIN) are not searched at all (delta pruning),
+  and the stand-pat score is evaluated lazily, since in lopsided positions
+  the material balance alone decides the outcome of the node.
+
   Return the score of the best line of play within the horizon established
   by MAX_QUIESCENCE_DEPTH.
   ============================================================================*/
 int
 AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
 {
+   PROFILE_ZONE ("quiescence");
+
    vector<Move> moves;
    int tentative_value, node_value;
    int best_value = MATE_VALUE;
 
-   this->n_nodes_evaluated++;
-   node_value = this->position_evaluator->static_evaluation (board);
+   if (is_search_stopped ())
+      return 0;
+
+   // The first node of a quiescence search is the horizon node of alpha_beta,
+   // which has already been counted
+   if (depth > 0)
+   {
+      if (this->tree_log != nullptr)
+         this->tree_log->enter (
+             max_depth + depth, SearchTreeLog::QUIESCENCE, alpha, beta, this->statistics.nodes);
+
+      this->statistics.count_quiescence_node (max_depth + depth);
+      check_search_limits ();
+   }
+
+   node_value = this->position_evaluator->lazy_evaluation (board, alpha, beta);
 
    // Assumption made: making a move will improve the position
    // In zugzwang positions, this is not true.
    if (node_value >= beta)
    {
-      this->n_leaf_nodes++;
+      this->statistics.leaf_nodes++;
 
       return node_value;
    }
@@ -350,25 +1048,25 @@ AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
       alpha = node_value;
 
    // Failing to pay attention to an ongoing check has fatal consequences
-   if (depth >= MAX_QUIESCENCE_DEPTH && !this->board->is_king_in_check ())
+   bool is_king_in_check = this->board->is_king_in_check ();
+   if (depth >= MAX_QUIESCENCE_DEPTH && !is_king_in_check)
    {
-      this->n_leaf_nodes++;
+      this->statistics.leaf_nodes++;
 
       return node_value;
    }
    this->move_generator->generate_moves (
        this->board, moves,
        MoveGenerator::CAPTURES |
-       MoveGenerator::CHECKS   |
        MoveGenerator::CHECK_EVASIONS |
        MoveGenerator::PAWN_PROMOTIONS);
 
    // A checkmate
-   if (this->board->is_king_in_check () && moves.size () == 0)
+   if (is_king_in_check && moves.size () == 0)
    {
-      this->n_leaf_nodes++;
+      this->statistics.leaf_nodes++;
 
-      return MATE_VALUE;
+      return MATE_VALUE + max_depth + depth;
    }
 
    // An apparently quiescent position
@@ -377,18 +1075,44 @@ AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
       // Make sure none of the pieces of the player in turn is being
       // attacked by a lower value piece
       this->move_generator->generate_en_prise_evations (this->board, moves);
+   }
 
-      if (moves.size () == 0)
-      {
-         this->n_leaf_nodes++;
+   // Quiet checks are only tried right at the horizon, since they could
+   // make the quiescence search go on forever
+   if (depth == 0 && !is_king_in_check)
+      this->move_generator->generate_quiet_checks (this->board, moves);
 
-         return node_value;
-      }
+   if (moves.size () == 0)
+   {
+      this->statistics.leaf_nodes++;
+
+      return node_value;
    }
 
-   this->n_internal_nodes++;
+   int material_weight = this->position_evaluator->get_material_weight ();
+
+   this->statistics.internal_nodes++;
    for (uint i = 0, n = moves.size (); i < n; ++i)
    {
+      // Delta pruning: skip captures that are hopeless even if the captured
+      // piece were won for free. This is unsound when in check, since then
+      // all evasions must be tried.
+      Move::Type move_type = moves[i].get_type ();
+      if (!is_king_in_check &&
+          (move_type == Move::NORMAL_CAPTURE || move_type == Move::EN_PASSANT_CAPTURE))
+      {
+         Piece::Type victim = (move_type == Move::EN_PASSANT_CAPTURE ?
+                               Piece::PAWN : moves[i].get_captured_piece ());
+
+         int optimistic_value =
+               node_value +
+               material_weight * (this->position_evaluator->get_piece_value (victim) +
+                                  DELTA_PRUNING_MARGIN);
+
+         if (optimistic_value <= alpha)
+            continue;
+      }
+
       IBoard::Error error = this->board->make_move (moves[i], /* is_computer_move: */ true);
       if (error == IBoard::KING_LEFT_IN_CHECK)
          continue;
@@ -396,11 +1120,20 @@ AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
       if (error == IBoard::DRAW_BY_REPETITION)
          tentative_value = DRAW_VALUE;
       else
+      {
          tentative_value = -quiescence (depth + 1, -beta, -alpha);
 
-      this->average_branching_factor++;
+         if (this->tree_log != nullptr)
+            this->tree_log->leave (
+                max_depth + depth + 1, moves[i], -tentative_value, this->statistics.nodes);
+      }
+
+      this->statistics.moves_made++;
 
-      assert(this->board->undo_move ());
+      VERIFY (this->board->undo_move ());
+
+      if (is_search_stopped ())
+         return 0;
 
       if (tentative_value > best_value)
       {
@@ -411,15 +1144,23 @@ AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
 
          best_value = tentative_value;
          if (best_value >= beta) // Alpha-beta cutoff
+         {
+            if (this->tree_log != nullptr)
+               this->tree_log->set_cutoff (max_depth + depth, i);
             break;
+         }
       }
    }
 
    // If all the possible violent moves (captures, checks, pawn promotions, ...)
    // are bad, we are not forced to make any move, unless we are in check
-   if (best_value < node_value && !this->board->is_king_in_check ())
+   if (best_value < node_value && !is_king_in_check)
       best_value = node_value;
 
+   // None of the evasions was legal
+   else if (best_value == MATE_VALUE)
+      best_value = MATE_VALUE + max_depth + depth;
+
    return best_value;
 }
 
@@ -431,12 +1172,9 @@ AlphaBetaSearch::quiescence (uint depth, int alpha, int beta)
   ============================================================================*/
 bool
 AlphaBetaSearch::build_principal_variation (
-    IBoard* board, vector<Move>& principal_variation)
+    MaeBoard* board, vector<Move>& principal_variation)
 {
-   BoardKey key = {
-      board->get_hash_key (),
-      board->get_hash_lock ()
-   };
+   BoardKey key = board->get_hash_key ();
    TranspositionTable::BoardEntry entry;
    bool return_value = true;
 
@@ -452,17 +1190,17 @@ AlphaBetaSearch::build_principal_variation (
             principal_variation.pop_back ();
             return_value = false;
          }
-         assert(board->undo_move ());
+         VERIFY (board->undo_move ());
       }
       else if (error != IBoard::KING_LEFT_IN_CHECK &&
                error != IBoard::DRAW_BY_REPETITION)
       {
-         assert(board->undo_move ());
+         VERIFY (board->undo_move ());
          return_value = false;
       }
       else if (error == IBoard::DRAW_BY_REPETITION)
       {
-         assert(board->undo_move ());
+         VERIFY (board->undo_move ());
       }
    }
 
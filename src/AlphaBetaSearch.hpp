@@ -9,44 +9,128 @@
 #include "Util.hpp"
 #include "IEngine.hpp"
 #include "Move.hpp"
+#include "RootMoveList.hpp"
 
 #include <stack>
 #include <fstream>
 #include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+namespace game_rules { class MaeBoard; }
 
 namespace game_engine
 {
-class IPositionEvaluator;
+class PositionEvaluator;
 class TranspositionTable;
 class MoveGenerator;
 
+/*==============================================================================
+  The engine is bound to MaeBoard. IBoard stays the interface of the user
+  interfaces and of the game readers, but the search, and the move generator,
+  position evaluator and pieces below it, call MaeBoard directly, so that the
+  calls made at every node are inlined rather than virtual: the generator and
+  the evaluator are templates on the board, instantiated for MaeBoard besides
+  their IBoard overrides, and the pieces take a MaeBoard. get_best_move
+  returns ERROR for any other board.
+  ==============================================================================*/
 class AlphaBetaSearch : public IEngine
 {
   private:
+   int root_search (int alpha, int beta);
    int alpha_beta (uint depth, int alpha, int beta);
    int quiescence (uint depth, int alpha, int beta);
    int iterative_deepening (std::vector<game_rules::Move>& principal_variation);
+   int aspiration_search (int expected_value, uint& search_window_size);
 
-   void print_statistics (std::vector<game_rules::Move>& principal_variation);
+   void print_statistics (const std::vector<game_rules::Move>& principal_variation);
    void reset_statistics ();
 
-   bool build_principal_variation (game_rules::IBoard*, std::vector<game_rules::Move>& principal_variation);
+   bool build_principal_variation (game_rules::MaeBoard*, std::vector<game_rules::Move>& principal_variation);
+   void build_line (const game_rules::Move& root_move, std::vector<game_rules::Move>& principal_variation);
    void load_factor_weights (std::vector<int>& weights);
 
-   IPositionEvaluator* position_evaluator;
+   int get_reported_score (int value) const;
+   int to_centipawns (int value) const;
+
+   bool is_search_stopped () const;
+   void check_search_limits ();
+   double get_elapsed_time () const;
+   void finish_search ();
+
+   void report_progress (
+       uint depth, uint line, int score, const std::vector<game_rules::Move>& principal_variation);
+   void report_root_move (int score, const game_rules::Move& move);
+
+   // Held by their classes rather than their interfaces, so that the calls
+   // the search makes to them, and theirs to the board, are direct
+   PositionEvaluator* position_evaluator;
    MoveGenerator* move_generator;
    TranspositionTable* transposition_table;
-   game_rules::IBoard* board;
+   game_rules::MaeBoard* board;
 
    GameResult result;
-   uint hash_table_hits;
    game_rules::Move best_move;
+   game_rules::Move root_best_move;
+   std::vector<game_rules::Move> principal_variation;
+   std::chrono::steady_clock::time_point search_start;
+
+   // The legal moves of the root, ordered by what the previous iterations
+   // found out about them, and the moves the next search is restricted to
+   RootMoveList root_moves;
+   std::vector<game_rules::Move> search_moves;
+
+   // MultiPV: the best lines found by the last completed iteration, and the
+   // root moves to skip while searching for the next line
+   struct RootLine
+   {
+      int value;
+      std::vector<game_rules::Move> principal_variation;
+   };
+
+   uint multi_pv;
+   std::vector<RootLine> root_lines;
+   std::vector<game_rules::Move> excluded_root_moves;
+
+   // Search control, shared with the thread that started the search
+   std::mutex control_mutex;
+   bool is_searching;
+   uint target_depth;
+   std::atomic<uint> completed_depth;
+   std::atomic<bool> is_infinite;
+   std::atomic<bool> stop_requested;
+   ullong node_limit;
+   uint time_limit;
+   uint mate_limit;
+
+   // The clock is only looked at every this many nodes (plus one)
+   static const ullong TIME_CHECK_INTERVAL = 1023;
 
   public:
-   AlphaBetaSearch (IPositionEvaluator*, MoveGenerator*);
+   AlphaBetaSearch (PositionEvaluator*, MoveGenerator*);
    ~AlphaBetaSearch ();
 
-   GameResult get_best_move (uint depth, game_rules::IBoard*, game_rules::Move& best_move);
+   using IEngine::get_best_move;
+   GameResult get_best_move (const SearchLimits& limits, game_rules::IBoard*, game_rules::Move& best_move);
+   void get_principal_variation (std::vector<game_rules::Move>& principal_variation) const;
+   void set_multi_pv (uint lines);
+   void get_lines (std::vector<Line>& lines) const;
+
+   void prepare_search ();
+   void start_infinite_search ();
+   void start_pondering ();
+   void ponder_hit ();
+   void stop ();
+
+   void set_search_moves (const std::vector<game_rules::Move>& moves);
+   void get_root_moves (std::vector<RootMoveStatistics>& root_moves) const;
+   void set_hash_size (uint megabytes);
+
+   // Conversions of the values stored in the transposition table by a node
+   // PLY plies away from the root
+   static int to_table_score (int value, uint ply);
+   static int from_table_score (int value, uint ply);
 };
 
 } // namespace game_engine
@@ -0,0 +1,45 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/*==============================================================================
+  Searches a fixed set of positions (openings, middlegames and endgames) to a
+  fixed depth, starting each one with an empty transposition table, and
+  reports the nodes visited and the time taken.
+
+  Since the search is deterministic, the total number of nodes is a signature
+  of its behaviour: it only changes when a change to the engine makes it
+  search a different tree, while the nodes per second measure its speed.
+  ==============================================================================*/
+
+#include <ostream>
+
+#include "Util.hpp"
+
+namespace game_rules { class IBoard; }
+namespace game_engine { class IEngine; }
+
+namespace diagnostics
+{
+class Bench
+{
+  public:
+   static const uint DEFAULT_DEPTH = 5;
+
+   // Size (in megabytes) of the transposition table used for each position
+   static const uint HASH_SIZE = 16;
+
+   Bench (game_rules::IBoard* board, game_engine::IEngine* engine);
+
+   ullong run (uint depth, std::ostream& out);
+
+   // FEN strings of the positions, ending with a null pointer
+   static const char* const POSITIONS[];
+
+  private:
+   game_rules::IBoard* board;
+   game_engine::IEngine* engine;
+};
+
+} // namespace diagnostics
+
+#endif // BENCH_H
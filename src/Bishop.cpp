@@ -1,12 +1,15 @@
 #include "Bishop.hpp"
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 #include <iostream>
 
 namespace game_rules
 {
+const bool Bishop::moves_computed = Bishop::compute_moves ();
+bitboard Bishop::moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
+bitboard Bishop::all_moves_from[BOARD_SQUARES_COUNT];
+
 Bishop::Bishop ()
 {
-   compute_moves ();
 }
 
 Bishop::~Bishop ()
@@ -21,7 +24,17 @@ Bishop::~Bishop ()
   moves
   ==============================================================================*/
 bitboard
-Bishop::get_moves (uint square, Piece::Player player, const IBoard* board) const
+Bishop::get_moves (uint square, Piece::Player player, const MaeBoard* board) const
+{
+   return get_attacks (square, player, board) & ~board->get_pieces (player);
+}
+
+/*==============================================================================
+  Get all squares attacked from SQUARE in the current BOARD, i.e. the squares
+  along each diagonal up to and including the first piece found
+  ==============================================================================*/
+bitboard
+Bishop::get_attacks (uint square, Piece::Player /* player */, const MaeBoard* board) const
 {
    bitboard attacks = 0;
    bitboard blocking_pieces;
@@ -44,7 +57,6 @@ Bishop::get_moves (uint square, Piece::Player player, const IBoard* board) const
             get_diagonal_ray_from (BoardSquare (square), ray) ^
             (blocking_pieces ? get_diagonal_ray_from (first_blocking_piece, ray) : 0);
    }
-   attacks &= ~board->get_pieces (player);
 
    return attacks;
 }
@@ -53,7 +65,7 @@ Bishop::get_moves (uint square, Piece::Player player, const IBoard* board) const
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ==============================================================================*/
-void
+bool
 Bishop::compute_moves ()
 {
    int dx[Piece::RAY_DIRECTIONS_COUNT] = { +1, +1, -1, -1 };
@@ -63,9 +75,9 @@ Bishop::compute_moves ()
    for (auto square = BoardSquare::a8; square <= BoardSquare::h1; ++square)
    {
       for (uint ray = 0; ray < Piece::RAY_DIRECTIONS_COUNT; ++ray)
-         this->moves_from[square][ray] = 0;
+         moves_from[square][ray] = 0;
 
-      this->all_moves_from[square] = 0;
+      all_moves_from[square] = 0;
    }
 
    for (uint row = 0; row < BOARD_SIZE; ++row)
@@ -92,11 +104,13 @@ Bishop::compute_moves ()
             {
                y += dy[ray];
                x += dx[ray];
-               this->moves_from[square][ray] |= (one << (y * BOARD_SIZE + x));
+               moves_from[square][ray] |= (one << (y * BOARD_SIZE + x));
             }
-            this->all_moves_from[square] |= this->moves_from[square][ray];
+            all_moves_from[square] |= moves_from[square][ray];
          }
       }
+
+   return true;
 }
 
 /*==============================================================================
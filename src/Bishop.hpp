@@ -12,23 +12,25 @@
 
 namespace game_rules
 {
-class IBoard;
+class MaeBoard;
 
-class Bishop : public Piece
+class Bishop final : public Piece
 {
   public:
    Bishop ();
    ~Bishop ();
 
-   bitboard get_moves (uint square, Player player, const IBoard* board) const;
+   bitboard get_moves (uint square, Player player, const MaeBoard* board) const;
+   bitboard get_attacks (uint square, Player player, const MaeBoard* board) const;
    bitboard get_potential_moves (uint square, Player player) const;
 
   private:
    bitboard get_diagonal_ray_from (BoardSquare square, Diagonal direction) const;
-   void compute_moves ();
-
-   bitboard moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
-   bitboard all_moves_from[BOARD_SQUARES_COUNT];
+   // Computed once, and shared by every board
+   static bitboard moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
+   static bitboard all_moves_from[BOARD_SQUARES_COUNT];
+   static bool compute_moves ();
+   static const bool moves_computed;
 };
 
 } // namespace game_rules
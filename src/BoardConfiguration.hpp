@@ -7,6 +7,7 @@
   ==============================================================================*/
 
 #include "Move.hpp"
+#include "GameTraits.hpp"
 
 namespace game_rules
 {
@@ -14,25 +15,27 @@ struct BoardConfiguration
 {
    BoardConfiguration (const Move& move,
                 bitboard en_passant,
-                bool can_castle_king_side,
-                bool can_castle_queen_side,
-                ullong hash_key,
-                ullong hash_lock)
+                const bool can_castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT],
+                uint fifty_move_counter,
+                ullong hash_key)
    {
       this->move = move;
       this->en_passant_capture_square = en_passant;
-      this->can_castle_king_side = can_castle_king_side;
-      this->can_castle_queen_side = can_castle_queen_side;
+      for (uint player = 0; player < PLAYERS_COUNT; ++player)
+         for (uint side = 0; side < CASTLE_SIDES_COUNT; ++side)
+            this->can_castle[player][side] = can_castle[player][side];
+      this->fifty_move_counter = fifty_move_counter;
       this->hash_key = hash_key;
-      this->hash_lock = hash_lock;
    }
 
    Move move;
    bitboard en_passant_capture_square;
-   bool can_castle_king_side;
-   bool can_castle_queen_side;
+
+   // Capturing a rook on its corner takes castling away from the opponent,
+   // so the privileges of both players are kept
+   bool can_castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+   uint fifty_move_counter;
    ullong hash_key;
-   ullong hash_lock;
 };
 
 } // namespace game_rules
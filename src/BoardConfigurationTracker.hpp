@@ -6,6 +6,7 @@
   ==============================================================================*/
 
 #include <unordered_map>
+#include <cstddef>
 
 #include "Util.hpp"
 #include "BoardKey.hpp"
@@ -30,18 +31,10 @@ class BoardConfigurationTracker
      public:
       size_t operator ()(const BoardKey& board) const
       {
-         return (size_t) (board.hash_key % size);
+         return (size_t) (board % size);
       }
    };
-   class board_comparer
-   {
-     public:
-      bool operator ()(const BoardKey& board, const BoardKey& other) const
-      {
-         return board.hash_lock == other.hash_lock;
-      }
-   };
-   std::unordered_map <BoardKey, ushort, board_hasher, board_comparer> tracker;
+   std::unordered_map <BoardKey, ushort, board_hasher> tracker;
 };
 
 } // namespace game_rules
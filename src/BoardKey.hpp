@@ -5,11 +5,8 @@
 
 namespace game_rules
 {
-   struct BoardKey
-   {
-      ullong hash_key;
-      ullong hash_lock;
-   };
+   // Zobrist key of a board configuration (see MaeBoard::compute_zobrist)
+   typedef ullong BoardKey;
 }
 
 #endif // BOARD_KEY_H
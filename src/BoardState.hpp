@@ -0,0 +1,50 @@
+#ifndef BOARD_STATE_H
+#define BOARD_STATE_H
+
+/*==============================================================================
+  Everything a chess position is made of (where the pieces are, whose turn it
+  is, castling and en-passant rights, the hash key and the 50-move counter),
+  but nothing about how it was reached. It holds no pointers, so it can be
+  copied as a plain block of memory, e.g. to give each search thread a board
+  of its own, or to keep a snapshot of a position.
+  ==============================================================================*/
+
+#include <type_traits>
+
+#include "Util.hpp"
+#include "Square.hpp"
+#include "GameTraits.hpp"
+
+namespace game_rules
+{
+using util::bitboard;
+
+struct BoardState
+{
+   // Basic board representation
+   bitboard piece[PLAYERS_COUNT][PIECE_KINDS_COUNT];
+   bitboard pieces[PLAYERS_COUNT];
+   bitboard all_pieces;
+   Square board[BOARD_SQUARES_COUNT];
+
+   ullong hash_key;
+
+   // Special moves information
+   bool can_do_castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+   bool is_castled_[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+   bitboard en_passant_capture_square;
+
+   // Turn information
+   bool is_whites_turn;
+   Piece::Player player, opponent;
+
+   // Counter used to detect draws by the 50-move rule
+   uint fifty_move_counter;
+};
+
+static_assert (std::is_trivially_copyable<BoardState>::value,
+               "A BoardState must be copyable as a plain block of memory");
+
+} // namespace game_rules
+
+#endif // BOARD_STATE_H
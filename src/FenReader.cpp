@@ -0,0 +1,216 @@
+#include "FenReader.hpp"
+#include "GameTraits.hpp"
+#include "Move.hpp"
+
+#include <sstream>
+#include <cctype>
+
+namespace game_persistence
+{
+using std::string;
+
+using game_rules::IBoard;
+using game_rules::Piece;
+using game_rules::BoardSquare;
+using game_rules::BOARD_SIZE;
+using game_rules::BOARD_SQUARES_COUNT;
+
+const string FenReader::INITIAL_POSITION =
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+FenReader::FenReader (const string& fen, IBoard* board)
+{
+   this->fen = fen;
+   this->board = board;
+}
+
+/*=============================================================================
+  Return TRUE if THIS->FEN is a valid position, which is then set up on
+  THIS->BOARD.
+
+  Precondition: THIS->BOARD is empty (see IBoard::clear).
+
+  The half-move clock and the move number are optional and ignored, since the
+  board keeps no record of them apart from its own history.
+  ===========================================================================*/
+bool
+FenReader::set_position ()
+{
+   std::istringstream fields (this->fen);
+   string placement, turn, castling = "-", en_passant = "-";
+
+   if (!(fields >> placement >> turn))
+      return false;
+
+   fields >> castling >> en_passant;
+
+   return (set_pieces (placement) &&
+           set_player_in_turn (turn) &&
+           set_castling_privileges (castling) &&
+           set_en_passant_square (en_passant));
+}
+
+/*=============================================================================
+  The ranks go from the eighth to the first, separated by slashes, and each
+  one must describe exactly BOARD_SIZE squares
+  ===========================================================================*/
+bool
+FenReader::set_pieces (const string& placement)
+{
+   uint rank = 0, file = 0;
+   uint kings[game_rules::PLAYERS_COUNT] = { 0, 0 };
+
+   for (uint i = 0; i < placement.length (); ++i)
+   {
+      char letter = placement[i];
+      Piece::Type type;
+      Piece::Player player;
+
+      if (letter == '/')
+      {
+         if (file != BOARD_SIZE || ++rank == BOARD_SIZE)
+            return false;
+         file = 0;
+      }
+      else if (letter >= '1' && letter <= '8')
+      {
+         file += letter - '0';
+         if (file > BOARD_SIZE)
+            return false;
+      }
+      else if (get_piece (letter, type, player))
+      {
+         if (file == BOARD_SIZE)
+            return false;
+
+         this->board->add_piece (BoardSquare (rank * BOARD_SIZE + file), type, player);
+         if (type == Piece::KING)
+            kings[player]++;
+         file++;
+      }
+      else
+         return false;
+   }
+
+   return (rank == BOARD_SIZE - 1 && file == BOARD_SIZE &&
+           kings[Piece::WHITE] == 1 && kings[Piece::BLACK] == 1);
+}
+
+bool
+FenReader::set_player_in_turn (const string& turn)
+{
+   if (turn != "w" && turn != "b")
+      return false;
+
+   this->board->set_player_in_turn (turn == "w" ? Piece::WHITE : Piece::BLACK);
+   return true;
+}
+
+/*=============================================================================
+  A castling privilege is only valid while the king and the rook involved are
+  still on their initial squares; otherwise the castling moves generated, and
+  the hash key, would not match the board.
+  ===========================================================================*/
+bool
+FenReader::set_castling_privileges (const string& castling)
+{
+   using namespace game_rules;
+
+   // Indexed by player and castle side
+   const char letters[PLAYERS_COUNT][CASTLE_SIDES_COUNT] = { { 'K', 'Q' }, { 'k', 'q' } };
+   const BoardSquare king_squares[PLAYERS_COUNT] = { e1, e8 };
+   const BoardSquare rook_squares[PLAYERS_COUNT][CASTLE_SIDES_COUNT] = { { h1, a1 }, { h8, a8 } };
+
+   if (castling != "-" && castling.find_first_not_of ("KQkq") != string::npos)
+      return false;
+
+   for (uint player = Piece::WHITE; player < PLAYERS_COUNT; ++player)
+      for (uint side = KING_SIDE; side < CASTLE_SIDES_COUNT; ++side)
+      {
+         Piece::Player color = Piece::Player (player);
+         bool is_allowed = castling.find (letters[player][side]) != string::npos;
+
+         if (is_allowed && (!is_piece_on (king_squares[player], Piece::KING, color) ||
+                            !is_piece_on (rook_squares[player][side], Piece::ROOK, color)))
+         {
+            return false;
+         }
+
+         this->board->set_castling_privilege (color, CastleSide (side), is_allowed);
+      }
+
+   return true;
+}
+
+bool
+FenReader::is_piece_on (BoardSquare square, Piece::Type type, Piece::Player player) const
+{
+   return (this->board->get_piece (square) == type &&
+           this->board->get_piece_color (square) == player);
+}
+
+/*=============================================================================
+  The en-passant square is only set if a pawn of the player in turn can
+  actually capture on it, the same way MaeBoard does when a pawn makes a
+  two-square move, so that the hash keys of both positions agree.
+  ===========================================================================*/
+bool
+FenReader::set_en_passant_square (const string& notation)
+{
+   if (notation == "-")
+      return true;
+
+   BoardSquare square;
+   if (!game_rules::Move::translate_to_square (notation, square))
+      return false;
+
+   Piece::Player player = this->board->get_player_in_turn ();
+   Piece::Player opponent = (player == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
+
+   // The pawn that has just moved lies right in front of the en-passant square
+   int pawn_square = (player == Piece::WHITE ? square + BOARD_SIZE : square - BOARD_SIZE);
+   if (pawn_square < 0 || pawn_square >= (int) BOARD_SQUARES_COUNT ||
+       this->board->get_piece (BoardSquare (pawn_square)) != Piece::PAWN ||
+       this->board->get_piece_color (BoardSquare (pawn_square)) != opponent)
+   {
+      return false;
+   }
+
+   int column = pawn_square % BOARD_SIZE;
+   for (int side = -1; side <= 1; side += 2)
+   {
+      int neighbour = pawn_square + side;
+      if (column + side < 0 || column + side >= (int) BOARD_SIZE)
+         continue;
+
+      if (this->board->get_piece (BoardSquare (neighbour)) == Piece::PAWN &&
+          this->board->get_piece_color (BoardSquare (neighbour)) == player)
+      {
+         this->board->set_en_passant_capture_square (square);
+         break;
+      }
+   }
+
+   return true;
+}
+
+bool
+FenReader::get_piece (char letter, Piece::Type& type, Piece::Player& player)
+{
+   switch (tolower (letter))
+   {
+   case 'p': type = Piece::PAWN; break;
+   case 'n': type = Piece::KNIGHT; break;
+   case 'b': type = Piece::BISHOP; break;
+   case 'r': type = Piece::ROOK; break;
+   case 'q': type = Piece::QUEEN; break;
+   case 'k': type = Piece::KING; break;
+   default:
+      return false;
+   }
+
+   player = (isupper (letter) ? Piece::WHITE : Piece::BLACK);
+   return true;
+}
+
+} // namespace game_persistence
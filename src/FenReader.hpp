@@ -0,0 +1,42 @@
+#ifndef FEN_READER_H
+#define FEN_READER_H
+
+/*==============================================================================
+  Reads chess positions in Forsyth-Edwards Notation (FEN), as sent by GUIs
+  through the UCI 'position fen' and the Xboard 'setboard' commands
+  ==============================================================================*/
+
+#include <string>
+
+#include "IBoard.hpp"
+#include "Piece.hpp"
+
+namespace game_persistence
+{
+class FenReader
+{
+  public:
+   FenReader (const std::string& fen, game_rules::IBoard* board);
+
+   bool set_position ();
+
+   static const std::string INITIAL_POSITION;
+
+  private:
+   game_rules::IBoard* board;
+   std::string fen;
+
+   bool set_pieces (const std::string& placement);
+   bool set_player_in_turn (const std::string& turn);
+   bool set_castling_privileges (const std::string& castling);
+   bool set_en_passant_square (const std::string& square);
+
+   bool is_piece_on (game_rules::BoardSquare square, game_rules::Piece::Type type,
+                     game_rules::Piece::Player player) const;
+
+   static bool get_piece (char letter, game_rules::Piece::Type& type, game_rules::Piece::Player& player);
+};
+
+} // namespace game_persistence
+
+#endif // FEN_READER_H
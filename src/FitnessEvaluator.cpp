@@ -5,6 +5,7 @@
 #include "MaeBoard.hpp"
 #include "Move.hpp"
 #include "Timer.hpp"
+#include "Profiler.hpp"
 
 #include <cstdlib>
 
@@ -32,6 +33,8 @@ FitnessEvaluator::~FitnessEvaluator ()
 double
 FitnessEvaluator::evaluate (Chromosome& a, Chromosome& b)
 {
+   PROFILE_ZONE ("FitnessEvaluator::evaluate");
+
    double evaluation = 0.0;
    std::vector<int> features[2];
 
@@ -57,7 +60,6 @@ FitnessEvaluator::evaluate (Chromosome& a, Chromosome& b)
 
       // TODO: enable again once we implement the assertion below
       // bitboard key = this->board->get_hash_key ();
-      // bitboard lock = this->board->get_hash_lock ();
 
       game_rules::Move move;
       result = this->chess_engine->get_best_move (3, this->board, move);
@@ -66,7 +68,7 @@ FitnessEvaluator::evaluate (Chromosome& a, Chromosome& b)
           result == IEngine::STALEMATE) break;
 
       // TODO: turn into an assertion
-      // if (key == this->board->get_hash_key () || lock != this->board->get_hash_lock ())
+      // if (key == this->board->get_hash_key ())
       // {
       // }
 
@@ -1,6 +1,8 @@
 #include "GeneticAlgorithm.hpp"
 #include "FitnessEvaluator.hpp"
 #include "Chromosome.hpp"
+#include "Profiler.hpp"
+#include "Logger.hpp"
 
 #include <iostream>
 #include <cstdlib>
@@ -24,7 +26,12 @@ GeneticAlgorithm::GeneticAlgorithm (
 void
 GeneticAlgorithm::run ()
 {
-   initialize_population ();
+   PROFILE_ZONE ("GeneticAlgorithm::run");
+
+   {
+      PROFILE_ZONE ("initialize_population");
+      initialize_population ();
+   }
 
    uint subpopulation_size = (uint)(this->population_size * SELECTION_PERCENTAGE);
    if (util::is_odd(subpopulation_size))
@@ -32,12 +39,22 @@ GeneticAlgorithm::run ()
 
    for (uint i = 0; i < this->iterations_count; ++i)
    {
-      evaluate_population ();
-      set_actual_fitness ();
+      PROFILE_ZONE ("generation");
+
+      {
+         PROFILE_ZONE ("evaluate_population");
+         evaluate_population ();
+         set_actual_fitness ();
+      }
 
       vector<Chromosome> parents;
       parents.clear ();
-      select_breeding_individuals (this->population, subpopulation_size, parents);
+      {
+         PROFILE_ZONE ("select_breeding_individuals");
+         select_breeding_individuals (this->population, subpopulation_size, parents);
+      }
+
+      PROFILE_ZONE ("reproduction");
 
       vector<Chromosome> offspring;
       offspring.clear ();
@@ -87,7 +104,7 @@ GeneticAlgorithm::converge ()
 void
 GeneticAlgorithm::reduce_population (uint size)
 {
-   std::cerr << "Reducing this population . . ." << '\n';
+   LOG_INFO ("Reducing this population by %u individuals", size);
 
    sort (this->population.begin (), this->population.end ());
 
@@ -225,7 +242,8 @@ GeneticAlgorithm::set_actual_fitness ()
             break;
 
          default:
-            std::cerr<< "an unclasified individual";
+            LOG_ERROR ("An unclassified individual");
+            diagnostics::Logger::flush ();
             abort();
       }
 
@@ -311,7 +329,9 @@ GeneticAlgorithm::set_duration_fitness(
       best_result = total.back ();
    else
    {
+      // Only wins and losses are scored by their duration
       assert(false);
+      return;
    }
 
    for (uint i = 0; i < size; ++i)
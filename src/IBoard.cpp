@@ -17,24 +17,6 @@ IBoard::~IBoard ()
 {
 }
 
-bool
-IBoard::is_inside_board (int row, int col)
-{
-   return (row >= 0 && row < (int)BOARD_SIZE) && (col >= 0 && col < (int)BOARD_SIZE);
-}
-
-bool
-IBoard::is_inside_board (uint row, uint col)
-{
-   return (row < BOARD_SIZE) && (col < BOARD_SIZE);
-}
-
-bool
-IBoard::is_inside_board (uint square)
-{
-   return (square < BOARD_SQUARES_COUNT);
-}
-
 std::ostream&
 operator << (std::ostream& out, const IBoard& board)
 {
@@ -14,6 +14,8 @@
 #include "Util.hpp"
 #include "Piece.hpp"
 #include "BoardTraits.hpp"
+#include "GameTraits.hpp"
+#include "BoardState.hpp"
 
 namespace game_rules
 {
@@ -44,6 +46,11 @@ class IBoard
 
    virtual bool load_game (const std::string& file) = 0;
    virtual bool save_game (const std::string& file) = 0;
+   virtual bool load_fen (const std::string& fen) = 0;
+
+   // The position alone, without the moves that led to it (see BoardState)
+   virtual const BoardState& get_state () const = 0;
+   virtual void set_state (const BoardState& state) = 0;
 
    virtual bool add_piece (
        const std::string& location, Piece::Type piece, Piece::Player player) = 0;
@@ -59,6 +66,33 @@ class IBoard
 
    virtual void label_move (Move& move) const = 0;
 
+   /*---------------------------------------------------------------------------
+     Attack information about the current position, computed the first time it
+     is asked for and kept until the position changes, so that move
+     generation, legality checks and evaluation share it. CHECKERS are the
+     pieces giving check to the king of the player in turn, and PINNED the
+     pieces of that player that cannot leave the line between their king and
+     an enemy slider.
+
+     The player in turn gives check by moving a piece of a given type to one
+     of its CHECK_SQUARES, or by moving one of the DISCOVERED_CHECKERS off
+     the line between one of its sliders and the enemy king.
+     --------------------------------------------------------------------------*/
+   struct AttackMap
+   {
+      bitboard attacked_by[PLAYERS_COUNT];
+      bitboard attacked_by_piece[PLAYERS_COUNT][PIECE_KINDS_COUNT];
+      bitboard checkers;
+      bitboard pinned;
+      bitboard check_squares[PIECE_KINDS_COUNT];
+      bitboard discovered_checkers;
+   };
+
+   virtual const AttackMap& get_attack_map () const = 0;
+
+   // Return TRUE if MOVE, a pseudo-legal move, would give check once made
+   virtual bool gives_check (const Move& move) const = 0;
+
    virtual bool is_king_in_check () const = 0;
    virtual bitboard attacks_to (BoardSquare location, bool include_king) const = 0;
    virtual bitboard threats_to (BoardSquare location, Piece::Type type) const = 0;
@@ -79,7 +113,6 @@ class IBoard
    virtual Piece::Player get_player_in_turn () const = 0;
    virtual Piece::Type get_piece (BoardSquare square) const = 0;
    virtual ullong get_hash_key () const = 0;
-   virtual ullong get_hash_lock () const = 0;
    virtual uint get_move_number () const = 0;
    virtual ushort get_repetition_count () const = 0;
 
@@ -96,6 +129,25 @@ class IBoard
    friend std::ostream& operator << (std::ostream& out, const IBoard& board);
 };
 
+// Called all over move generation, hence defined here so they get inlined
+inline bool
+IBoard::is_inside_board (int row, int col)
+{
+   return (row >= 0 && row < (int)BOARD_SIZE) && (col >= 0 && col < (int)BOARD_SIZE);
+}
+
+inline bool
+IBoard::is_inside_board (uint row, uint col)
+{
+   return (row < BOARD_SIZE) && (col < BOARD_SIZE);
+}
+
+inline bool
+IBoard::is_inside_board (uint square)
+{
+   return (square < BOARD_SQUARES_COUNT);
+}
+
 inline BoardSquare&
 operator ++ (BoardSquare& square)
 {
@@ -2,11 +2,18 @@
 #define ICHESS_ENGINE_H
 
 #include "Util.hpp"
+#include "SearchStatistics.hpp"
+#include "ISearchObserver.hpp"
+#include "SearchLimits.hpp"
+
+#include <ostream>
 
 namespace game_rules { class IBoard; class Move; }
 
 namespace game_engine
 {
+class SearchTreeLog;
+
 class IEngine
 {
   public:
@@ -22,21 +29,144 @@ class IEngine
 
    static const int DRAW_VALUE = 0;
    static const int MATE_VALUE = -util::constants::INFINITUM;
+
+   // Mate scores depend on the distance to the mate: being mated N plies away
+   // from the root scores MATE_VALUE + N, so that shorter mates are preferred.
+   // No line is searched deeper than MAX_MATE_PLY plies, so any score that
+   // close to MATE_VALUE (or to -MATE_VALUE) is a mate score.
+   static const int MAX_MATE_PLY = 256;
+
+   static bool is_mate_score (int score)
+   {
+      return (score <= MATE_VALUE + MAX_MATE_PLY || score >= -MATE_VALUE - MAX_MATE_PLY);
+   }
+
+   // Moves (not plies) to the mate of a mate SCORE, negative if the side to
+   // move is the one getting mated
+   static int get_mate_distance (int score)
+   {
+      return (score > 0 ? (-MATE_VALUE - score + 1) / 2 : -((score - MATE_VALUE + 1) / 2));
+   }
+
    static const uint MAX_QUIESCENCE_DEPTH = 4;
 
+   // Deepest iteration a search without a depth limit (e.g. pondering or
+   // analysis) does
+   static const uint MAX_SEARCH_DEPTH = 32;
+
+   // Safety margin (in centipawns) added to the value of a captured piece
+   // before deciding the capture cannot possibly raise alpha
+   static const int DELTA_PRUNING_MARGIN = 200;
+
+   // Internal iterative deepening: nodes at least IID_MIN_DEPTH plies away
+   // from the horizon that have no move from the transposition table to try
+   // first are searched IID_REDUCTION plies shallower to find one
+   static const uint IID_MIN_DEPTH = 4;
+   static const uint IID_REDUCTION = 2;
+
    IEngine () {}
    virtual ~IEngine () {}
 
    virtual void load_factor_weights (std::vector<int>& weights) = 0;
-   virtual GameResult get_best_move (uint depth, game_rules::IBoard*, game_rules::Move& best_move) = 0;
+   virtual GameResult get_best_move (
+       const SearchLimits& limits, game_rules::IBoard*, game_rules::Move& best_move) = 0;
+
+   // Search to DEPTH plies, without any other limit
+   GameResult get_best_move (uint depth, game_rules::IBoard* board, game_rules::Move& best_move)
+   {
+      SearchLimits limits;
+      limits.depth = depth;
+      return get_best_move (limits, board, best_move);
+   }
+
+   virtual void get_principal_variation (std::vector<game_rules::Move>& principal_variation) const = 0;
+
+   /*---------------------------------------------------------------------------
+     MultiPV: make the searches find the best LINES lines (i.e. the best LINES
+     root moves with their exact scores) instead of only the best one. The
+     score of a line is in centipawns, from the point of view of the side to
+     move, or the number of moves to the mate if IS_MATE (see
+     get_mate_distance).
+     --------------------------------------------------------------------------*/
+   struct Line
+   {
+      int score;
+      bool is_mate;
+      std::vector<game_rules::Move> principal_variation;
+   };
+
+   virtual void set_multi_pv (uint lines) = 0;
+   virtual void get_lines (std::vector<Line>& lines) const = 0;
+
+   /*---------------------------------------------------------------------------
+     Searches can be controlled from another thread. Before starting a search
+     in another thread, call prepare_search (), so that a stop () issued
+     before the search actually begins is not lost, or
+     start_infinite_search (), so that it also keeps deepening past its DEPTH
+     until stop () is called (as SearchLimits::infinite does). A ponder
+     search is an infinite search that ponder_hit () may turn into a normal
+     one. A stopped search returns the result of the last iteration it
+     completed.
+     --------------------------------------------------------------------------*/
+   virtual void prepare_search () = 0;
+   virtual void start_infinite_search () = 0;
+   virtual void start_pondering () = 0;
+   virtual void ponder_hit () = 0;
+   virtual void stop () = 0;
+
+   /*---------------------------------------------------------------------------
+     Restrict the next search to the root moves in MOVES (an empty list, or
+     one without any legal move, allows all of them), as the UCI
+     'searchmoves' does.
+     --------------------------------------------------------------------------*/
+   virtual void set_search_moves (const std::vector<game_rules::Move>& moves) = 0;
+
+   /*---------------------------------------------------------------------------
+     What the last search found about every root move, in the order the next
+     iteration would have tried them: its score in centipawns (exact for the
+     best lines only, a bound for the rest) and the nodes spent on it by the
+     last iteration and by the whole search.
+     --------------------------------------------------------------------------*/
+   struct RootMoveStatistics
+   {
+      game_rules::Move move;
+      int score;
+      ullong nodes;
+      ullong total_nodes;
+   };
+
+   virtual void get_root_moves (std::vector<RootMoveStatistics>& root_moves) const = 0;
+
+   // Replace the transposition table by an empty one of (at most) MEGABYTES
+   virtual void set_hash_size (uint megabytes) = 0;
+
+   const SearchStatistics& get_statistics () const { return this->statistics; }
+
+   // Write the statistics of every search as a JSON line to OUT (a null
+   // pointer disables the output)
+   void set_statistics_output (std::ostream* out) { this->statistics_output = out; }
+
+   // Count the hardware events (see diagnostics::PerfCounters) of every
+   // search along with the rest of its statistics
+   void set_hardware_counting (bool enabled) { this->count_hardware_events = enabled; }
+
+   // Write the nodes visited by every search to LOG (a null pointer disables
+   // the log)
+   void set_tree_log (SearchTreeLog* log) { this->tree_log = log; }
+
+   // Send the progress of every search to OBSERVER (a null pointer disables
+   // the reports)
+   void set_search_observer (ISearchObserver* observer) { this->search_observer = observer; }
 
   protected:
    uint max_depth;
-   uint n_nodes_evaluated;
-   uint n_internal_nodes;
-   uint n_leaf_nodes;
-   uint average_branching_factor;
    int root_value;
+
+   SearchStatistics statistics;
+   std::ostream* statistics_output = nullptr;
+   bool count_hardware_events = false;
+   ISearchObserver* search_observer = nullptr;
+   SearchTreeLog* tree_log = nullptr;
 };
 
 } // namespace game_engine
@@ -29,6 +29,12 @@ class IMoveGenerator
 
    virtual bool generate_moves (game_rules::IBoard*, std::vector<game_rules::Move>& moves) = 0;
    virtual bool generate_en_prise_evations (game_rules::IBoard*, std::vector<game_rules::Move>& moves) = 0;
+
+   /*----------------------------------------------------------------------
+     Add to MOVES the pseudo-legal moves that give check without capturing
+     or promoting (which quiescence search already tries anyway)
+     ---------------------------------------------------------------------*/
+   virtual bool generate_quiet_checks (game_rules::IBoard*, std::vector<game_rules::Move>& moves) = 0;
 };
 
 } // namespace game_engine
@@ -13,6 +13,7 @@ class IPositionEvaluator
   public:
    virtual ~IPositionEvaluator () {}
    virtual int static_evaluation (const game_rules::IBoard* board) const = 0;
+   virtual int lazy_evaluation (const game_rules::IBoard* board, int alpha, int beta) const = 0;
 
    virtual int evaluate_material (const game_rules::IBoard* board) const = 0;
    virtual int evaluate_mobility (const game_rules::IBoard* board) const = 0;
@@ -21,6 +22,7 @@ class IPositionEvaluator
 
    virtual void load_factor_weights (std::vector<int>& weights) = 0;
    virtual int get_piece_value (game_rules::Piece::Type piece_type) const = 0;
+   virtual int get_material_weight () const = 0;
 };
 
 } // namespace game_engine
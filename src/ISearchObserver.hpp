@@ -0,0 +1,43 @@
+#ifndef ISEARCH_OBSERVER_H
+#define ISEARCH_OBSERVER_H
+
+/*==============================================================================
+  Receives progress reports from a running search (e.g. to show the thinking
+  output of the engine in a GUI). Reports are sent from the thread running the
+  search, so observers must not take long to process them.
+  ==============================================================================*/
+
+#include <vector>
+
+#include "Util.hpp"
+#include "Move.hpp"
+
+namespace game_engine
+{
+struct SearchReport
+{
+   uint depth;
+   uint line;         // Index of the line, starting at 1, in MultiPV searches
+   int score;         // In centipawns, from the point of view of the side to move
+   bool is_mate;      // If TRUE, SCORE is the number of moves to the mate instead
+   double elapsed_ms;
+   ullong nodes;
+   uint hashfull;     // Usage of the transposition table, in permill
+   std::vector<game_rules::Move> principal_variation;
+};
+
+class ISearchObserver
+{
+  public:
+   virtual ~ISearchObserver () {}
+
+   /*----------------------------------------------------------------------
+     Called after every completed iteration, and whenever the best move at
+     the root changes in the middle of one
+     ---------------------------------------------------------------------*/
+   virtual void on_search_report (const SearchReport& report) = 0;
+};
+
+} // namespace game_engine
+
+#endif // ISEARCH_OBSERVER_H
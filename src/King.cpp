@@ -1,17 +1,17 @@
 #include "King.hpp"
 #include <iostream>
-#include <memory>
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 
 namespace game_rules
 {
+// The neighbors are computed from the moves, so these must come first
+const bool King::moves_computed = King::compute_moves ();
+bitboard King::moves_from[BOARD_SQUARES_COUNT];
+
 const bool King::neighbors_computed = King::compute_neighbors ();
 bitboard King::neighbors[BOARD_SQUARES_COUNT];
 
-King:: King ()
-{
-   compute_moves ();
-}
+King::King () { }
 
 King::~King () { }
 
@@ -20,7 +20,7 @@ King::~King () { }
   PLAYER's turn to move (moves that leave the king in check are also included)
   ============================================================================*/
 bitboard
-King::get_moves (uint square, Player player, const IBoard* board) const
+King::get_moves (uint square, Player player, const MaeBoard* board) const
 {
    if (!IBoard::is_inside_board (square))
       return 0;
@@ -31,6 +31,9 @@ King::get_moves (uint square, Player player, const IBoard* board) const
    // Include castling moves as valid
    if (BoardSquare (square) == board->get_initial_king_square (player))
    {
+      Player opponent = (player == WHITE ? BLACK : WHITE);
+      bitboard one = util::constants::ONE;
+
       // Ensure there are no pieces between the rook and the king
       if (board->can_castle (player, CastleSide::KING_SIDE) &&
           !(all_pieces & (util::constants::ONE << (square + 1))) &&
@@ -38,9 +41,8 @@ King::get_moves (uint square, Player player, const IBoard* board) const
       {
          // Make sure there are no attacks on squares the king has to pass
          // through while castling
-         if (!board->attacks_to (BoardSquare (square), false) &&
-             !board->attacks_to (BoardSquare (square + 1), false) &&
-             !board->attacks_to (BoardSquare (square + 2), false))
+         bitboard path = (one << square) | (one << (square + 1)) | (one << (square + 2));
+         if (!(board->get_attack_map ().attacked_by[opponent] & path))
          {
             attacks |= (util::constants::ONE << (square + 2));
          }
@@ -53,9 +55,8 @@ King::get_moves (uint square, Player player, const IBoard* board) const
       {
          // Make sure there are no attacks on squares the king has to pass
          // through while castling
-         if (!board->attacks_to (BoardSquare (square), false) &&
-             !board->attacks_to (BoardSquare (square - 1), false) &&
-             !board->attacks_to (BoardSquare (square - 2), false))
+         bitboard path = (one << square) | (one << (square - 1)) | (one << (square - 2));
+         if (!(board->get_attack_map ().attacked_by[opponent] & path))
          {
             attacks |= (util::constants::ONE << (square - 2));
          }
@@ -66,6 +67,15 @@ King::get_moves (uint square, Player player, const IBoard* board) const
    return attacks;
 }
 
+/*=============================================================================
+  Castling is a move, but not an attack
+  ============================================================================*/
+bitboard
+King::get_attacks (uint square, Player player, const MaeBoard* /* board */) const
+{
+   return get_potential_moves (square, player);
+}
+
 bitboard
 // Only for pawns is the player to move relevant in computing the potential moves
 King:: get_potential_moves (uint square, Player /* player */) const
@@ -77,14 +87,14 @@ King:: get_potential_moves (uint square, Player /* player */) const
 }
 
 
-void
+bool
 King::compute_moves ()
 {
    int dx[KING_MOVES_COUNT] = {-1,  0, +1, +1, +1,  0, -1, -1};
    int dy[KING_MOVES_COUNT] = {+1, +1, +1,  0, -1, -1, -1,  0};
 
    for (uint square = 0; square < BOARD_SQUARES_COUNT; square++)
-      this->moves_from[square] = 0;
+      moves_from[square] = 0;
 
    for (uint row = 0; row < BOARD_SIZE; ++row)
       for (uint col = 0; col < BOARD_SIZE; ++col)
@@ -115,9 +125,11 @@ King::compute_moves ()
             int x = col + dx[jump];
 
             if (IBoard::is_inside_board (y, x))
-               this->moves_from[square] |= (util::constants::ONE << (y * BOARD_SIZE + x));
+               moves_from[square] |= (util::constants::ONE << (y * BOARD_SIZE + x));
          }
       }
+
+   return true;
 }
 
 bitboard
@@ -131,18 +143,16 @@ King::get_neighbors (uint position)
 bool
 King::compute_neighbors ()
 {
-   std::unique_ptr<Piece> king(new King());
-
    for (uint position = 0; position < BOARD_SQUARES_COUNT; ++position)
    {
-      bitboard neighborhood = king->get_potential_moves (position, Piece::WHITE);
+      bitboard neighborhood = moves_from[position];
       bitboard actual_neighbors = neighborhood;
 
       int square = util::Util::MSB_position (neighborhood);
 
       while (neighborhood && square != -1)
       {
-         actual_neighbors |= king->get_potential_moves (square, Piece::WHITE);
+         actual_neighbors |= moves_from[square];
          neighborhood ^= (util::constants::ONE << square);
          square = util::Util::MSB_position (neighborhood);
       }
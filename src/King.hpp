@@ -12,22 +12,25 @@
 
 namespace game_rules
 {
-class IBoard;
+class MaeBoard;
 
-class King : public Piece
+class King final : public Piece
 {
   public:
    King ();
    ~King ();
 
-   bitboard get_moves (uint square, Player, const IBoard*) const;
+   bitboard get_moves (uint square, Player, const MaeBoard*) const;
+   bitboard get_attacks (uint square, Player, const MaeBoard*) const;
    bitboard get_potential_moves (uint square, Player) const;
 
    static bitboard get_neighbors (uint position);
 
   private:
-   void compute_moves ();
-   bitboard moves_from[BOARD_SQUARES_COUNT];
+   // Computed once, and shared by every board
+   static bitboard moves_from[BOARD_SQUARES_COUNT];
+   static bool compute_moves ();
+   static const bool moves_computed;
 
    static bitboard neighbors[BOARD_SQUARES_COUNT];
    static bool compute_neighbors ();
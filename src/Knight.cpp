@@ -4,14 +4,14 @@
   ==============================================================================*/
 
 #include "Knight.hpp"
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 
 namespace game_rules
 {
-Knight::Knight ()
-{
-   compute_moves ();
-}
+const bool Knight::moves_computed = Knight::compute_moves ();
+bitboard Knight::moves_from[BOARD_SQUARES_COUNT];
+
+Knight::Knight () { }
 
 Knight::~Knight () { }
 
@@ -20,7 +20,7 @@ Knight::~Knight () { }
   PLAYER's turn to move (moves that leave the king in check are also included)
   ============================================================================*/
 bitboard
-Knight::get_moves (uint square, Player player, const IBoard* board) const
+Knight::get_moves (uint square, Player player, const MaeBoard* board) const
 {
    bitboard attacks = get_potential_moves (square, player);
    attacks &= ~board->get_pieces (player);
@@ -28,6 +28,12 @@ Knight::get_moves (uint square, Player player, const IBoard* board) const
    return attacks;
 }
 
+bitboard
+Knight::get_attacks (uint square, Player player, const MaeBoard* /* board */) const
+{
+   return get_potential_moves (square, player);
+}
+
 /*=============================================================================
   Return all possible moves from SQUARE, assuming the board is empty.
   ============================================================================*/
@@ -45,14 +51,14 @@ Knight::get_potential_moves (uint square, Player /* player */) const
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ============================================================================*/
-void
+bool
 Knight::compute_moves ()
 {
    int dx[KNIGHT_MOVES_COUNT] = {+1, +2, +2, +1, -1, -2, -2, -1};
    int dy[KNIGHT_MOVES_COUNT] = {-2, -1, +1, +2, +2, +1, -1, -2};
 
    for (uint square = 0; square < BOARD_SQUARES_COUNT; ++square)
-      this->moves_from[square] = 0;
+      moves_from[square] = 0;
 
    for (uint row = 0; row < BOARD_SIZE; ++row)
       for (uint col = 0; col < BOARD_SIZE; ++col)
@@ -79,9 +85,11 @@ Knight::compute_moves ()
             int y = row + dy[jump];
             int x = col + dx[jump];
             if (IBoard::is_inside_board (y, x))
-               this->moves_from[square] |= (util::constants::ONE << (y * BOARD_SIZE + x));
+               moves_from[square] |= (util::constants::ONE << (y * BOARD_SIZE + x));
          }
       }
+
+   return true;
 }
 
 } // namespace game_rules
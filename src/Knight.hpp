@@ -12,21 +12,23 @@
 
 namespace game_rules
 {
-class IBoard;
+class MaeBoard;
 
-class Knight : public Piece
+class Knight final : public Piece
 {
   public:
    Knight ();
    ~Knight ();
 
-   bitboard get_moves (uint square, Player, const IBoard*) const;
+   bitboard get_moves (uint square, Player, const MaeBoard*) const;
+   bitboard get_attacks (uint square, Player, const MaeBoard*) const;
    bitboard get_potential_moves (uint square, Player) const;
 
   private:
-   void compute_moves ();
-
-   bitboard moves_from[BOARD_SQUARES_COUNT];
+   // Computed once, and shared by every board
+   static bitboard moves_from[BOARD_SQUARES_COUNT];
+   static bool compute_moves ();
+   static const bool moves_computed;
 };
 
 } // namespace game_rules
@@ -0,0 +1,195 @@
+#include "Logger.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+namespace diagnostics
+{
+namespace
+{
+const char* const level_names[] = { "debug", "info", "warning", "error" };
+}
+
+const uint Logger::FLUSH_PERIOD_MS;
+
+Logger::Logger ()
+{
+   this->origin = std::chrono::steady_clock::now ();
+   this->is_stopping = false;
+   this->flusher = std::thread (&Logger::run_flusher, this);
+}
+
+/*==============================================================================
+  Stop the flusher, which writes whatever is still buffered on its way out
+  ==============================================================================*/
+Logger::~Logger ()
+{
+   {
+      std::lock_guard<std::mutex> lock (this->flush_mutex);
+      this->is_stopping = true;
+   }
+   this->wake_flusher.notify_one ();
+   this->flusher.join ();
+}
+
+Logger&
+Logger::get_instance ()
+{
+   static Logger instance;
+   return instance;
+}
+
+/*==============================================================================
+  Return the ring of the calling thread, which only that thread ever writes
+  to. A new thread takes over the ring of a finished one, if there is one
+  whose messages have all been written out, or else gets a ring of its own.
+  ==============================================================================*/
+Logger::Ring&
+Logger::get_thread_ring ()
+{
+   static thread_local RingOwner owner;
+
+   if (owner.ring == nullptr)
+   {
+      Logger& logger = get_instance ();
+      std::lock_guard<std::mutex> lock (logger.rings_mutex);
+
+      for (const std::unique_ptr<Ring>& ring : logger.rings)
+      {
+         bool is_drained =
+               (ring->head.load (std::memory_order_acquire) ==
+                ring->tail.load (std::memory_order_relaxed) &&
+                ring->dropped.load (std::memory_order_relaxed) == 0);
+
+         if (!ring->is_owned.load (std::memory_order_acquire) && is_drained)
+         {
+            owner.ring = ring.get ();
+            break;
+         }
+      }
+
+      if (owner.ring == nullptr)
+      {
+         logger.rings.push_back (std::unique_ptr<Ring> (new Ring ()));
+         owner.ring = logger.rings.back ().get ();
+         owner.ring->id = logger.rings.size () - 1;
+         owner.ring->head = 0;
+         owner.ring->tail = 0;
+         owner.ring->dropped = 0;
+      }
+
+      owner.ring->is_owned.store (true, std::memory_order_relaxed);
+   }
+
+   return *owner.ring;
+}
+
+/*==============================================================================
+  Run on the exit of the thread, after its last message was buffered
+  ==============================================================================*/
+Logger::RingOwner::~RingOwner ()
+{
+   if (this->ring != nullptr)
+      this->ring->is_owned.store (false, std::memory_order_release);
+}
+
+/*==============================================================================
+  Format the message into the ring of the calling thread, or drop it if the
+  ring is full. Errors wake the flusher up instead of waiting for its period.
+  ==============================================================================*/
+void
+Logger::log (Level level, const char* format, ...)
+{
+   Logger& logger = get_instance ();
+   Ring& ring = get_thread_ring ();
+
+   uint tail = ring.tail.load (std::memory_order_relaxed);
+   if (tail - ring.head.load (std::memory_order_acquire) == RING_SIZE)
+   {
+      ring.dropped.fetch_add (1, std::memory_order_relaxed);
+      return;
+   }
+
+   Message& message = ring.messages[tail & (RING_SIZE - 1)];
+   message.level = level;
+   message.time_us = std::chrono::duration_cast<std::chrono::microseconds> (
+       std::chrono::steady_clock::now () - logger.origin).count ();
+
+   va_list arguments;
+   va_start (arguments, format);
+   std::vsnprintf (message.text, MAX_MESSAGE_LENGTH, format, arguments);
+   va_end (arguments);
+
+   ring.tail.store (tail + 1, std::memory_order_release);
+
+   if (level == ERROR)
+      logger.wake_flusher.notify_one ();
+}
+
+void
+Logger::flush ()
+{
+   Logger& logger = get_instance ();
+   std::lock_guard<std::mutex> lock (logger.flush_mutex);
+
+   logger.write_messages ();
+}
+
+void
+Logger::run_flusher ()
+{
+   std::unique_lock<std::mutex> lock (this->flush_mutex);
+
+   while (!this->is_stopping)
+   {
+      this->wake_flusher.wait_for (lock, std::chrono::milliseconds (FLUSH_PERIOD_MS));
+      write_messages ();
+   }
+}
+
+/*==============================================================================
+  Write out the messages buffered by every thread, one thread after another.
+  Must be called with flush_mutex held, so that each ring has a single
+  reader.
+  ==============================================================================*/
+void
+Logger::write_messages ()
+{
+   std::lock_guard<std::mutex> lock (this->rings_mutex);
+   bool is_written = false;
+
+   for (const std::unique_ptr<Ring>& ring : this->rings)
+   {
+      uint head = ring->head.load (std::memory_order_relaxed);
+      uint tail = ring->tail.load (std::memory_order_acquire);
+
+      for (; head != tail; ++head)
+      {
+         const Message& message = ring->messages[head & (RING_SIZE - 1)];
+
+         // Formatted apart, so as not to change the formatting of std::cerr
+         char prefix[48];
+         std::snprintf (prefix, sizeof (prefix), "[%12.6f] thread %u %s: ",
+                        message.time_us / 1E6, ring->id, level_names[message.level]);
+
+         std::cerr << prefix << message.text << '\n';
+         is_written = true;
+
+         ring->head.store (head + 1, std::memory_order_release);
+      }
+
+      ullong dropped = ring->dropped.exchange (0, std::memory_order_relaxed);
+      if (dropped > 0)
+      {
+         std::cerr << "thread " << ring->id << ": " << dropped
+                   << " messages dropped, the log could not keep up" << '\n';
+         is_written = true;
+      }
+   }
+
+   if (is_written)
+      std::cerr << std::flush;
+}
+
+} // namespace diagnostics
@@ -0,0 +1,130 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/*==============================================================================
+  Leveled diagnostic messages that never make the calling thread wait for
+  the terminal: LOG_WARNING ("format", ...) formats the message, printf-like,
+  into a ring buffer of the calling thread, and a background thread writes
+  the buffered messages of every thread to std::cerr.
+
+  Each ring has a single writer (its thread) and a single reader (whoever
+  flushes, under a mutex), so logging takes no lock. When a ring is full the
+  message is dropped and counted rather than waiting for the flusher. The
+  ring of a thread that has finished is handed to the next new thread that
+  logs once it has been written out, so a search thread per search does not
+  add a ring per search.
+
+  Messages below MAE_LOG_LEVEL are compiled out, arguments included (build
+  with 'make rebuild LOG_LEVEL=0' to see the debug messages of the search).
+  ==============================================================================*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Util.hpp"
+
+#define MAE_LOG_DEBUG 0
+#define MAE_LOG_INFO 1
+#define MAE_LOG_WARNING 2
+#define MAE_LOG_ERROR 3
+
+#ifndef MAE_LOG_LEVEL
+#define MAE_LOG_LEVEL MAE_LOG_INFO
+#endif
+
+#if MAE_LOG_LEVEL <= MAE_LOG_DEBUG
+#define LOG_DEBUG(...) diagnostics::Logger::log (diagnostics::Logger::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void) 0)
+#endif
+
+#if MAE_LOG_LEVEL <= MAE_LOG_INFO
+#define LOG_INFO(...) diagnostics::Logger::log (diagnostics::Logger::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void) 0)
+#endif
+
+#if MAE_LOG_LEVEL <= MAE_LOG_WARNING
+#define LOG_WARNING(...) diagnostics::Logger::log (diagnostics::Logger::WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void) 0)
+#endif
+
+#if MAE_LOG_LEVEL <= MAE_LOG_ERROR
+#define LOG_ERROR(...) diagnostics::Logger::log (diagnostics::Logger::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void) 0)
+#endif
+
+namespace diagnostics
+{
+class Logger
+{
+  public:
+   enum Level { DEBUG = MAE_LOG_DEBUG, INFO, WARNING, ERROR };
+
+   static const uint RING_SIZE = 256;           // Messages, a power of two
+   static const uint MAX_MESSAGE_LENGTH = 120;  // Longer messages are cut
+   static const uint FLUSH_PERIOD_MS = 20;
+
+   ~Logger ();
+
+   static void log (Level level, const char* format, ...)
+       __attribute__ ((format (printf, 2, 3)));
+
+   // Write every buffered message now, e.g. before aborting
+   static void flush ();
+
+  private:
+   struct Message
+   {
+      Level level;
+      ullong time_us;
+      char text[MAX_MESSAGE_LENGTH];
+   };
+
+   // The messages of a single thread
+   struct Ring
+   {
+      uint id;
+      std::atomic<uint> head;       // Next message to write out
+      std::atomic<uint> tail;       // Next free slot
+      std::atomic<ullong> dropped;
+      std::atomic<bool> is_owned;   // By a running thread
+      Message messages[RING_SIZE];
+   };
+
+   // Gives the ring of a thread back when the thread finishes
+   struct RingOwner
+   {
+      Ring* ring = nullptr;
+      ~RingOwner ();
+   };
+
+   Logger ();
+
+   static Logger& get_instance ();
+   static Ring& get_thread_ring ();
+
+   void run_flusher ();
+   void write_messages ();
+
+   std::chrono::steady_clock::time_point origin;
+
+   std::mutex rings_mutex;
+   std::vector<std::unique_ptr<Ring>> rings;
+
+   std::mutex flush_mutex;
+   std::condition_variable wake_flusher;
+   bool is_stopping;
+   std::thread flusher;
+};
+
+} // namespace diagnostics
+
+#endif // LOGGER_H
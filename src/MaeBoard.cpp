@@ -1,5 +1,6 @@
 #include "MaeBoard.hpp"
 #include "GameReader.hpp"
+#include "FenReader.hpp"
 #include "Rook.hpp"
 #include "Knight.hpp"
 #include "Bishop.hpp"
@@ -11,16 +12,25 @@ namespace game_rules
 {
 using std::string;
 using game_persistence::GameReader;
+using game_persistence::FenReader;
 
 const Square
 MaeBoard::EMPTY_SQUARE = { Piece::NULL_PLAYER, Piece::NULL_PIECE };
 
+const bool MaeBoard::zobrist_computed = MaeBoard::compute_zobrist ();
+ullong MaeBoard::zobrist[PIECE_KINDS_COUNT][PLAYERS_COUNT][BOARD_SQUARES_COUNT];
+ullong MaeBoard::turn_key;
+ullong MaeBoard::castle_key[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+ullong MaeBoard::en_passant_key[BOARD_SQUARES_COUNT];
+
+const bool MaeBoard::squares_between_computed = MaeBoard::compute_squares_between ();
+bitboard MaeBoard::squares_between[BOARD_SQUARES_COUNT][BOARD_SQUARES_COUNT];
+
 /*=============================================================================
   Build a new board as specified in the file initial.in
   ===========================================================================*/
 MaeBoard::MaeBoard ()
 {
-   load_zobrist ();
    load_support_data ();
    reset ();
 }
@@ -31,7 +41,6 @@ MaeBoard::MaeBoard ()
   =============================================================================*/
 MaeBoard::MaeBoard (const string& file)
 {
-   load_zobrist ();
    load_support_data ();
    clear ();
 
@@ -41,46 +50,46 @@ MaeBoard::MaeBoard (const string& file)
 
 MaeBoard::~MaeBoard ()
 {
-   for (Piece::Type piece = Piece::PAWN; piece <= Piece::KING; ++piece)
-      delete this->chessmen[piece];
-
    this->position_counter.reset ();
    while (!this->game_history.empty ())
       this->game_history.pop ();
 }
 
 /*=============================================================================
-  Create random 64-bit integers to help maintain the hash key for THIS board
+  Create the random 64-bit integers the hash key of every board is made of.
 
   Things to consider include pieces, castling privileges, turn and en_passant
-  capture possibility. A hash lock is also used to avoid collisions in the
-  hash table that serves as dictionary of board configurations in the Search
-  module.
+  capture possibility. The keys come from a generator of their own (SplitMix64)
+  rather than from rand (), whose sequence belongs to the genetic algorithm.
   =============================================================================*/
-void
-MaeBoard::load_zobrist ()
+bool
+MaeBoard::compute_zobrist ()
 {
-   srand (RANDOM_SEED);
+   ullong state = RANDOM_SEED;
+   auto next_key = [&state] () -> ullong {
+      ullong key = (state += 0x9E3779B97F4A7C15uLL);
+      key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9uLL;
+      key = (key ^ (key >> 27)) * 0x94D049BB133111EBuLL;
+      return key ^ (key >> 31);
+   };
 
    for (uint i = 0; i < Piece::PIECES_COUNT; ++i)
       for (uint j = 0; j < PLAYERS_COUNT; ++j)
          for (uint k = 0; k < BOARD_SQUARES_COUNT; ++k)
-            for (uint m = 0; m < HASH_KEYS_COUNT; ++m)
-               this->zobrist[i][j][k][m] = util::Util::random_ullong ();
+            zobrist[i][j][k] = next_key ();
 
-   this->turn_key = util::Util::random_ullong ();
-   this->castle_key[Piece::WHITE][KING_SIDE]  = util::Util::random_ullong ();
-   this->castle_key[Piece::WHITE][QUEEN_SIDE] = util::Util::random_ullong ();
-   this->castle_key[Piece::BLACK][KING_SIDE]  = util::Util::random_ullong ();
-   this->castle_key[Piece::BLACK][QUEEN_SIDE] = util::Util::random_ullong ();
+   turn_key = next_key ();
+   castle_key[Piece::WHITE][KING_SIDE]  = next_key ();
+   castle_key[Piece::WHITE][QUEEN_SIDE] = next_key ();
+   castle_key[Piece::BLACK][KING_SIDE]  = next_key ();
+   castle_key[Piece::BLACK][QUEEN_SIDE] = next_key ();
 
    // This is a waste of memory, since only 16 squares can be possible
    // en-passant capture squares, but this avoids dealing with awful offsets
    for (uint i = 0; i < BOARD_SQUARES_COUNT; ++i)
-      this->en_passant_key[i] = util::Util::random_ullong ();
+      en_passant_key[i] = next_key ();
 
-   this->hash_key = 0;
-   this->hash_lock = 0;
+   return true;
 }
 
 /*============================================================================
@@ -113,7 +122,7 @@ MaeBoard::clear ()
    this->en_passant_capture_square = 0;
    this->game_status = PENDING_GAME;
 
-   this->hash_key = this->hash_lock = 0;
+   this->hash_key = 0;
 
    this->position_counter.reset ();
 
@@ -121,6 +130,8 @@ MaeBoard::clear ()
       this->game_history.pop ();
 
    this->fifty_move_counter = 0;
+
+   forget_attack_map ();
 }
 
 /*=============================================================================
@@ -153,6 +164,54 @@ MaeBoard::load_game (const string& file)
    return loaded_correctly;
 }
 
+/*=============================================================================
+  Return TRUE if FEN is a valid position in Forsyth-Edwards Notation.
+
+  Postcondition: The board contains the position described by FEN, with no
+  history, or the initial position of a new game if FEN was invalid.
+  ===========================================================================*/
+bool
+MaeBoard::load_fen (const string& fen)
+{
+   clear ();
+
+   FenReader reader (fen, this);
+   if (!reader.set_position ())
+   {
+      reset ();
+      return false;
+   }
+
+   return true;
+}
+
+/*=============================================================================
+  Return the position on THIS board, which can be copied into any other board
+  with set_state
+  ===========================================================================*/
+const BoardState&
+MaeBoard::get_state () const
+{
+   return *this;
+}
+
+/*=============================================================================
+  Set up the position in STATE (e.g. taken from another board by get_state)
+
+  Postcondition: The board has no history, just as after load_fen.
+  ===========================================================================*/
+void
+MaeBoard::set_state (const BoardState& state)
+{
+   static_cast<BoardState&> (*this) = state;
+
+   this->position_counter.reset ();
+   while (!this->game_history.empty ())
+      this->game_history.pop ();
+
+   forget_attack_map ();
+}
+
 /*=============================================================================
   Return TRUE if the current game was successfully saved to FILENAME.
   ===========================================================================*/
@@ -194,8 +253,9 @@ MaeBoard::add_piece (BoardSquare square, Piece::Type type, Piece::Player player)
    this->board[square].player = player;
    this->board[square].piece = type;
 
-   this->hash_key ^= zobrist[type][player][square][0];
-   this->hash_lock ^= zobrist[type][player][square][1];
+   this->hash_key ^= zobrist[type][player][square];
+
+   forget_attack_map ();
 
    return true;
 }
@@ -234,8 +294,9 @@ MaeBoard::remove_piece (BoardSquare square)
 
    this->board[square] = EMPTY_SQUARE;
 
-   this->hash_key ^= this->zobrist[piece][player][square][0];
-   this->hash_lock ^= this->zobrist[piece][player][square][1];
+   this->hash_key ^= zobrist[piece][player][square];
+
+   forget_attack_map ();
 
    return true;
 }
@@ -251,6 +312,20 @@ MaeBoard::remove_piece (BoardSquare square)
 MaeBoard::Error
 MaeBoard::make_move (Move& move, bool is_computer_move)
 {
+   if (this->is_whites_turn)
+      return make_move<Piece::WHITE> (move, is_computer_move);
+
+   return make_move<Piece::BLACK> (move, is_computer_move);
+}
+
+/*=============================================================================
+  Same as above, for SIDE (the player in turn) known at compile time
+  ===========================================================================*/
+template <Piece::Player side>
+MaeBoard::Error
+MaeBoard::make_move (Move& move, bool is_computer_move)
+{
+   const Piece::Player opponent = PlayerTraits<side>::OPPONENT;
    Error move_error;
 
    if (this->board[move.from ()] == EMPTY_SQUARE)
@@ -269,7 +344,16 @@ MaeBoard::make_move (Move& move, bool is_computer_move)
       if ((move_error = can_move (move)) != NO_ERROR)
          return move_error;
 
+   // Only a move of the king, of a pinned piece, or made while in check can
+   // leave the king in check, apart from en-passant captures (which take two
+   // pieces off the same row at once)
    label_move (move);
+   bool may_leave_king_in_check =
+         (move.get_moving_piece () == Piece::KING ||
+          move.get_type () == Move::EN_PASSANT_CAPTURE ||
+          get_checkers () ||
+          (get_pinned_pieces () & util::Util::to_bitboard[start]));
+
    save_restore_information (move);
 
    Square initial = board[start];
@@ -278,15 +362,13 @@ MaeBoard::make_move (Move& move, bool is_computer_move)
    remove_piece (end);
    add_piece (end, initial.piece, initial.player);
 
+   // The captured pawn is right behind the square the capturing pawn lands on
    if (move.get_type () == Move::EN_PASSANT_CAPTURE)
-   {
-      uint offset = this->is_whites_turn ? BOARD_SIZE: -((int) BOARD_SIZE);
-      uint position = util::Util::MSB_position (this->en_passant_capture_square) + offset;
-      remove_piece (BoardSquare (position));
-   }
+      remove_piece (BoardSquare (end - PlayerTraits<side>::PAWN_STEP));
 
-   int king_position = util::Util::MSB_position (this->piece[player][Piece::KING]);
-   if (attacks_to (BoardSquare (king_position), true /* include_king */))
+   int king_position = util::Util::MSB_position (this->piece[side][Piece::KING]);
+   if (may_leave_king_in_check &&
+       attacks_to (BoardSquare (king_position), true /* include_king */))
    {
       remove_piece (end);
       add_piece (start, initial.piece, initial.player);
@@ -294,26 +376,20 @@ MaeBoard::make_move (Move& move, bool is_computer_move)
          add_piece (end, final.piece, final.player);
 
       if (move.get_type () == Move::EN_PASSANT_CAPTURE)
-      {
-         int offset = (this->is_whites_turn ? BOARD_SIZE: -((int) BOARD_SIZE));
-         uint position = util::Util::MSB_position (en_passant_capture_square) + offset;
-         add_piece (BoardSquare (position), Piece::PAWN, opponent);
-      }
+         add_piece (BoardSquare (end - PlayerTraits<side>::PAWN_STEP), Piece::PAWN, opponent);
+
       this->game_history.pop ();
 
       return KING_LEFT_IN_CHECK;
    }
 
-   handle_en_passant_move (move);
-   handle_castling_privileges (move);
+   handle_en_passant_move<side> (move);
+   handle_castling_privileges<side> (move);
    handle_promotion_move (move);
 
    change_turn ();
 
-   if (is_king_in_check ())
-      move.set_type (Move::CHECK);
-
-   BoardKey key = { this->hash_key, this->hash_lock };
+   BoardKey key = this->hash_key;
    ushort times = 0;
    if (!this->position_counter.add_record (key, times) && times == 3)
       return DRAW_BY_REPETITION;
@@ -344,15 +420,30 @@ MaeBoard::make_move (Move& move, bool is_computer_move)
 bool
 MaeBoard::undo_move ()
 {
+   // The move to undo was made by the opponent of the player in turn
+   if (this->is_whites_turn)
+      return undo_move<Piece::BLACK> ();
+
+   return undo_move<Piece::WHITE> ();
+}
+
+/*=============================================================================
+  Same as above, for SIDE (the player who made the last move) known at
+  compile time
+  ===========================================================================*/
+template <Piece::Player side>
+bool
+MaeBoard::undo_move ()
+{
+   const Piece::Player opponent = PlayerTraits<side>::OPPONENT;
+
    if (this->game_history.empty ())
       return false;
 
    BoardConfiguration board_configuration = this->game_history.top ();
    Move move = board_configuration.move;
 
-   BoardKey key;
-   key.hash_key = this->hash_key;
-   key.hash_lock = this->hash_lock;
+   BoardKey key = this->hash_key;
 
    if(!this->position_counter.decrease_record (key))
    {
@@ -366,12 +457,11 @@ MaeBoard::undo_move ()
       return false;
    }
 
-   if (!add_piece (move.from (), move.get_moving_piece (), player))
+   if (!add_piece (move.from (), move.get_moving_piece (), side))
    {
       return false;
    }
 
-   int board_size;
    switch (move.get_type ())
    {
       case Move::NORMAL_CAPTURE:
@@ -382,8 +472,7 @@ MaeBoard::undo_move ()
          break;
 
       case Move::EN_PASSANT_CAPTURE:
-         board_size = (this->is_whites_turn ? BOARD_SIZE: -((int)BOARD_SIZE));
-         if (!add_piece (BoardSquare (move.to () + board_size), Piece::PAWN, opponent))
+         if (!add_piece (BoardSquare (move.to () - PlayerTraits<side>::PAWN_STEP), Piece::PAWN, opponent))
          {
             return false;
          }
@@ -394,11 +483,11 @@ MaeBoard::undo_move ()
          {
             return false;
          }
-         if (!add_piece (this->corner[player][KING_SIDE], Piece::ROOK, player))
+         if (!add_piece (PlayerTraits<side>::KING_SIDE_CORNER, Piece::ROOK, side))
          {
             return false;
          }
-         this->is_castled_[player][KING_SIDE] = false;
+         this->is_castled_[side][KING_SIDE] = false;
          break;
 
       case Move::CASTLE_QUEEN_SIDE:
@@ -406,16 +495,15 @@ MaeBoard::undo_move ()
          {
             return false;
          }
-         if (!add_piece (this->corner[player][QUEEN_SIDE], Piece::ROOK, player))
+         if (!add_piece (PlayerTraits<side>::QUEEN_SIDE_CORNER, Piece::ROOK, side))
          {
             return false;
          }
-         this->is_castled_[player][QUEEN_SIDE] = false;
+         this->is_castled_[side][QUEEN_SIDE] = false;
          break;
 
       case Move::PROMOTION_MOVE:
-         board_size = (this->is_whites_turn ? -((int)BOARD_SIZE): BOARD_SIZE);
-         if (move.from () + board_size != move.to ())
+         if (move.from () + PlayerTraits<side>::PAWN_STEP != move.to ())
             // There was a capture while doing the promotion
             if (!add_piece (move.to (), move.get_captured_piece (), opponent))
             {
@@ -430,17 +518,58 @@ MaeBoard::undo_move ()
          break;
    }
 
-   this->can_do_castle[player][KING_SIDE] = board_configuration.can_castle_king_side;
-   this->can_do_castle[player][QUEEN_SIDE] = board_configuration.can_castle_queen_side;
+   for (Piece::Player player = Piece::WHITE; player <= Piece::BLACK; ++player)
+   {
+      this->can_do_castle[player][KING_SIDE] = board_configuration.can_castle[player][KING_SIDE];
+      this->can_do_castle[player][QUEEN_SIDE] = board_configuration.can_castle[player][QUEEN_SIDE];
+   }
+   this->fifty_move_counter = board_configuration.fifty_move_counter;
    this->en_passant_capture_square = board_configuration.en_passant_capture_square;
    this->hash_key = board_configuration.hash_key;
-   this->hash_lock = board_configuration.hash_lock;
 
    this->game_history.pop ();
 
    return true;
 }
 
+/*=============================================================================
+  Return the pseudo-legal moves of a piece of TYPE and PLAYER on SQUARE, by
+  calling the rules of that kind of piece directly
+  ===========================================================================*/
+inline bitboard
+MaeBoard::get_piece_moves (Piece::Type type, uint square, Piece::Player player) const
+{
+   switch (type)
+   {
+      case Piece::PAWN:   return this->chessmen.pawn->get_moves (square, player, this);
+      case Piece::KNIGHT: return this->chessmen.knight->get_moves (square, player, this);
+      case Piece::BISHOP: return this->chessmen.bishop->get_moves (square, player, this);
+      case Piece::ROOK:   return this->chessmen.rook->get_moves (square, player, this);
+      case Piece::QUEEN:  return this->chessmen.queen->get_moves (square, player, this);
+      case Piece::KING:   return this->chessmen.king->get_moves (square, player, this);
+      default:            return 0;
+   }
+}
+
+/*=============================================================================
+  Return the squares a piece of TYPE and PLAYER on SQUARE attacks, whether
+  they are empty or hold a piece of either side
+  ===========================================================================*/
+inline bitboard
+MaeBoard::get_piece_attacks (Piece::Type type, uint square, Piece::Player player) const
+{
+   switch (type)
+   {
+      case Piece::PAWN:   return this->chessmen.pawn->get_attacks (square, player, this);
+      case Piece::KNIGHT: return this->chessmen.knight->get_attacks (square, player, this);
+      case Piece::BISHOP: return this->chessmen.bishop->get_attacks (square, player, this);
+      case Piece::ROOK:   return this->chessmen.rook->get_attacks (square, player, this);
+      case Piece::QUEEN:  return this->chessmen.queen->get_attacks (square, player, this);
+      case Piece::KING:   return this->chessmen.king->get_attacks (square, player, this);
+      default:            return 0;
+   }
+}
+
 /*=============================================================================
   Return NO_ERROR if the given piece can actually move from MOVE.FROM () to
   MOVE.TO () according to its own movement rules and the current board status.
@@ -461,7 +590,7 @@ MaeBoard::can_move (const Move& move) const
       return Error::OPPONENTS_TURN;
 
    bitboard valid_moves =
-         this->chessmen[move.get_moving_piece ()]->get_moves (start, this->player, this);
+         get_piece_moves (move.get_moving_piece (), start, this->player);
 
    // Is MOVE.TO () included in the set of valid moves from MOVE.FROM () ?
    if (util::Util::to_bitboard[move.to ()] & valid_moves)
@@ -527,7 +656,6 @@ MaeBoard::attacks_to (BoardSquare location, bool include_king) const
 {
    bitboard attackers = 0;
    bitboard pawn_attacks;
-   Pawn* pawn = (Pawn*) this->chessmen[Piece::PAWN];
    Piece::Type last_piece = (include_king ? Piece::KING : Piece::QUEEN);
 
    // Put a piece of TYPE in LOCATION and compute all its pseudo-moves.
@@ -536,11 +664,11 @@ MaeBoard::attacks_to (BoardSquare location, bool include_king) const
    for (Piece::Type type = Piece::KNIGHT; type <= last_piece; ++type)
    {
       attackers |=
-            this->chessmen[type]->get_moves (location, this->player, this) &
+            get_piece_moves (type, location, this->player) &
             this->piece[opponent][type];
    }
-   pawn_attacks = (pawn->get_capture_move (location, this->player, Piece::EAST) |
-                   pawn->get_capture_move (location, this->player, Piece::WEST));
+   pawn_attacks = (this->chessmen.pawn->get_capture_move (location, this->player, Piece::EAST) |
+                   this->chessmen.pawn->get_capture_move (location, this->player, Piece::WEST));
 
    attackers |= (pawn_attacks & this->piece[opponent][Piece::PAWN]);
 
@@ -556,16 +684,15 @@ MaeBoard::threats_to (BoardSquare location, Piece::Type type) const
 {
    bitboard attackers = 0;
    bitboard pawn_attackers;
-   Pawn* pawn = (Pawn*) this->chessmen[Piece::PAWN];
 
    for (Piece::Type attacked = type; attacked > Piece::PAWN; --attacked)
    {
       attackers |=
-            this->chessmen[type]->get_moves (location, this->player, this) &
+            get_piece_moves (type, location, this->player) &
             this->piece[opponent][type];
    }
-   pawn_attackers = (pawn->get_capture_move (location, this->player, Piece::EAST) |
-                     pawn->get_capture_move (location, this->player, Piece::WEST));
+   pawn_attackers = (this->chessmen.pawn->get_capture_move (location, this->player, Piece::EAST) |
+                     this->chessmen.pawn->get_capture_move (location, this->player, Piece::WEST));
 
    attackers |= (pawn_attackers & this->piece[opponent][Piece::PAWN]);
 
@@ -575,16 +702,283 @@ MaeBoard::threats_to (BoardSquare location, Piece::Type type) const
 bool
 MaeBoard::is_king_in_check () const
 {
-   uint king_location = util::Util::MSB_position (this->piece[player][Piece::KING]);
+   return get_checkers () != 0;
+}
+
+/*=============================================================================
+  Return the attack information of the current position, working out the
+  parts of it still unknown
+  ===========================================================================*/
+const IBoard::AttackMap&
+MaeBoard::get_attack_map () const
+{
+   get_checkers ();
+   get_pinned_pieces ();
+   get_check_squares ();
+
+   if (this->known_attack_map_parts & KNOWN_ATTACKS)
+      return this->attack_map;
+
+   for (Piece::Player side = Piece::WHITE; side <= Piece::BLACK; ++side)
+   {
+      this->attack_map.attacked_by[side] = 0;
+      for (Piece::Type type = Piece::PAWN; type <= Piece::KING; ++type)
+      {
+         bitboard attacks = 0;
+         bitboard pieces = this->piece[side][type];
+         while (pieces)
+         {
+            int square = util::Util::MSB_position (pieces);
+            attacks |= get_piece_attacks (type, square, side);
+            pieces ^= util::Util::to_bitboard[square];
+         }
+
+         this->attack_map.attacked_by_piece[side][type] = attacks;
+         this->attack_map.attacked_by[side] |= attacks;
+      }
+   }
+   this->known_attack_map_parts |= KNOWN_ATTACKS;
+
+   return this->attack_map;
+}
+
+/*=============================================================================
+  Get a bitboard containing all enemy pieces that give check to the king of
+  the player in turn
+  ===========================================================================*/
+bitboard
+MaeBoard::get_checkers () const
+{
+   if (this->known_attack_map_parts & KNOWN_CHECKERS)
+      return this->attack_map.checkers;
+
+   bitboard king = this->piece[player][Piece::KING];
 
    // The second argument is set to FALSE since one invariant of this class is
    // that no king can be in check by the other (such thing is illegal)
-   if (attacks_to (BoardSquare (king_location), /* include_king: */ false))
+   this->attack_map.checkers =
+         (king ? attacks_to (BoardSquare (util::Util::MSB_position (king)), false) : 0);
+   this->known_attack_map_parts |= KNOWN_CHECKERS;
+
+   return this->attack_map.checkers;
+}
+
+/*=============================================================================
+  Get a bitboard containing all pieces of the player in turn that are the
+  only piece between their king and an enemy bishop, rook or queen that
+  would attack it otherwise
+  ===========================================================================*/
+bitboard
+MaeBoard::get_pinned_pieces () const
+{
+   if (this->known_attack_map_parts & KNOWN_PINNED)
+      return this->attack_map.pinned;
+
+   this->attack_map.pinned = get_blockers (player, opponent) & this->pieces[player];
+   this->known_attack_map_parts |= KNOWN_PINNED;
+
+   return this->attack_map.pinned;
+}
+
+/*=============================================================================
+  Work out the squares from which each kind of piece of the player in turn
+  would attack the enemy king, and the pieces of that player whose move
+  would uncover an attack to it
+  ===========================================================================*/
+const IBoard::AttackMap&
+MaeBoard::get_check_squares () const
+{
+   if (this->known_attack_map_parts & KNOWN_CHECK_SQUARES)
+      return this->attack_map;
+
+   bitboard king = this->piece[opponent][Piece::KING];
+   for (Piece::Type type = Piece::PAWN; type <= Piece::KING; ++type)
+      this->attack_map.check_squares[type] = 0;
+   this->attack_map.discovered_checkers = 0;
+
+   if (king)
+   {
+      int king_square = util::Util::MSB_position (king);
+
+      // A piece attacks the king from the squares a piece of the same kind,
+      // but of the king's side, would attack from the king's square
+      for (Piece::Type type = Piece::PAWN; type < Piece::KING; ++type)
+         this->attack_map.check_squares[type] =
+               get_piece_attacks (type, king_square, opponent);
+
+      this->attack_map.discovered_checkers = get_blockers (opponent, player) & this->pieces[player];
+   }
+   this->known_attack_map_parts |= KNOWN_CHECK_SQUARES;
+
+   return this->attack_map;
+}
+
+/*=============================================================================
+  Get a bitboard containing all pieces, of either side, that are the only
+  piece between the king of KING_SIDE and a bishop, rook or queen of
+  SLIDER_SIDE that would attack it otherwise
+  ===========================================================================*/
+bitboard
+MaeBoard::get_blockers (Piece::Player king_side, Piece::Player slider_side) const
+{
+   bitboard king = this->piece[king_side][Piece::KING];
+   bitboard blockers = 0;
+
+   if (!king)
+      return 0;
+
+   int king_square = util::Util::MSB_position (king);
+   bitboard sliders =
+         ((this->piece[slider_side][Piece::BISHOP] | this->piece[slider_side][Piece::QUEEN]) &
+          this->chessmen.bishop->get_potential_moves (king_square, king_side)) |
+         ((this->piece[slider_side][Piece::ROOK] | this->piece[slider_side][Piece::QUEEN]) &
+          this->chessmen.rook->get_potential_moves (king_square, king_side));
+
+   while (sliders)
+   {
+      int square = util::Util::MSB_position (sliders);
+      bitboard in_between = this->squares_between[square][king_square] & this->all_pieces;
+
+      // Exactly one piece in between
+      if (in_between && !(in_between & (in_between - 1)))
+         blockers |= in_between;
+
+      sliders ^= util::Util::to_bitboard[square];
+   }
+
+   return blockers;
+}
+
+/*=============================================================================
+  Return TRUE if any of the DIAGONAL_SLIDERS (bishops and queens) or the
+  STRAIGHT_SLIDERS (rooks and queens) attacks TARGET when the occupied
+  squares are those in OCCUPANCY
+  ===========================================================================*/
+bool
+MaeBoard::is_attacked_by_sliders (
+    BoardSquare target, bitboard occupancy, bitboard diagonal_sliders, bitboard straight_sliders) const
+{
+   bitboard sliders =
+         (diagonal_sliders & this->chessmen.bishop->get_potential_moves (target, player)) |
+         (straight_sliders & this->chessmen.rook->get_potential_moves (target, player));
+
+   while (sliders)
+   {
+      int square = util::Util::MSB_position (sliders);
+      if (!(this->squares_between[square][target] & occupancy))
+         return true;
+
+      sliders ^= util::Util::to_bitboard[square];
+   }
+
+   return false;
+}
+
+/*=============================================================================
+  Return TRUE if MOVE would give check to the enemy king, without making it.
+  Promotions, en-passant captures and castling move (or remove) more than one
+  piece, so for them the sliders are checked against the resulting board.
+
+  Precondition: MOVE is pseudo-legal in the current board configuration.
+  ===========================================================================*/
+bool
+MaeBoard::gives_check (const Move& move) const
+{
+   const AttackMap& attack_map = get_check_squares ();
+   BoardSquare start = move.from ();
+   BoardSquare end = move.to ();
+   bitboard from = util::Util::to_bitboard[start];
+   bitboard to = util::Util::to_bitboard[end];
+
+   Move labeled_move = move;
+   labeled_move.set_moving_piece (this->board[start].piece);
+   label_move (labeled_move);
+
+   Piece::Type piece = this->board[start].piece;
+   Move::Type type = labeled_move.get_type ();
+   BoardSquare king = BoardSquare (util::Util::MSB_position (this->piece[opponent][Piece::KING]));
+
+   bitboard diagonal_sliders = this->piece[player][Piece::BISHOP] | this->piece[player][Piece::QUEEN];
+   bitboard straight_sliders = this->piece[player][Piece::ROOK] | this->piece[player][Piece::QUEEN];
+
+   switch (type)
+   {
+   case Move::PROMOTION_MOVE:
+      // The pawn becomes a queen on END
+      return is_attacked_by_sliders (
+          king, (this->all_pieces ^ from) | to, diagonal_sliders | to, straight_sliders | to);
+
+   case Move::CASTLE_KING_SIDE:
+   case Move::CASTLE_QUEEN_SIDE:
+   {
+      CastleSide side = (type == Move::CASTLE_KING_SIDE ? KING_SIDE : QUEEN_SIDE);
+      bitboard rook_from = util::Util::to_bitboard[this->corner[player][side]];
+      bitboard rook_to = util::Util::to_bitboard[side == KING_SIDE ? end - 1 : end + 1];
+      bitboard occupancy = (this->all_pieces ^ from ^ rook_from) | to | rook_to;
+
+      return is_attacked_by_sliders (
+          king, occupancy, diagonal_sliders, (straight_sliders ^ rook_from) | rook_to);
+   }
+
+   case Move::EN_PASSANT_CAPTURE:
+   {
+      int offset = (this->is_whites_turn ? BOARD_SIZE : -((int) BOARD_SIZE));
+      bitboard captured = util::Util::to_bitboard[end + offset];
+
+      return ((attack_map.check_squares[Piece::PAWN] & to) ||
+              is_attacked_by_sliders (
+                  king, (this->all_pieces ^ from ^ captured) | to, diagonal_sliders, straight_sliders));
+   }
+
+   default:
+      break;
+   }
+
+   // Direct check
+   if (attack_map.check_squares[piece] & to)
       return true;
 
+   // Discovered check, unless the piece stays on the line to the king
+   if (attack_map.discovered_checkers & from)
+   {
+      bool stays_on_line = ((this->squares_between[king][end] & from) ||
+                            (this->squares_between[king][start] & to));
+      if (!stays_on_line)
+         return true;
+   }
+
    return false;
 }
 
+/*=============================================================================
+  Fill the table of squares between two squares on the same line
+  ===========================================================================*/
+bool
+MaeBoard::compute_squares_between ()
+{
+   for (int from = 0; from < (int) BOARD_SQUARES_COUNT; ++from)
+      for (int to = 0; to < (int) BOARD_SQUARES_COUNT; ++to)
+      {
+         int row_step = (to / BOARD_SIZE > from / BOARD_SIZE) - (to / BOARD_SIZE < from / BOARD_SIZE);
+         int column_step = (to % BOARD_SIZE > from % BOARD_SIZE) - (to % BOARD_SIZE < from % BOARD_SIZE);
+         int rows = abs ((int) (to / BOARD_SIZE) - (int) (from / BOARD_SIZE));
+         int columns = abs ((int) (to % BOARD_SIZE) - (int) (from % BOARD_SIZE));
+
+         squares_between[from][to] = 0;
+         if (from == to || (rows != 0 && columns != 0 && rows != columns))
+            continue;
+
+         int square = from + row_step * BOARD_SIZE + column_step;
+         while (square != to)
+         {
+            squares_between[from][to] |= (util::constants::ONE << square);
+            square += row_step * BOARD_SIZE + column_step;
+         }
+      }
+
+   return true;
+}
+
 /*=============================================================================
   If a pawn has just moved, should we turn on the en-passant flag ?
 
@@ -592,46 +986,33 @@ MaeBoard::is_king_in_check () const
   (1) the pawn made a two-square move, and
   (2) there are enemy pawns to, at least, one of its sides.
   ============================================================================*/
+template <Piece::Player side>
 void
 MaeBoard::handle_en_passant_move (const Move& move)
 {
-   if (move.get_moving_piece () != Piece::PAWN)
-   {
-      if (this->en_passant_capture_square)
-      {
-         int square = util::Util::MSB_position (this->en_passant_capture_square);
-         this->hash_key ^= this->en_passant_key[square];
-         this->hash_lock ^= this->en_passant_key[square];
-      }
-      this->en_passant_capture_square = 0;
-      return;
-   }
-
-   Pawn* pawn = (Pawn*) this->chessmen[Piece::PAWN];
-   int start = (int) move.from ();
-   int end = (int) move.to ();
+   const Piece::Player opponent = PlayerTraits<side>::OPPONENT;
 
    if (this->en_passant_capture_square)
    {
       int square = util::Util::MSB_position (this->en_passant_capture_square);
-      hash_key ^= this->en_passant_key[square];
-      hash_lock ^= this->en_passant_key[square];
+      this->hash_key ^= this->en_passant_key[square];
    }
    this->en_passant_capture_square = 0;
 
-   // Turn the en-passant flag if necessary
-   if ((pawn->get_side_moves (end, player) & this->piece[opponent][Piece::PAWN]) &&
-       (abs (end - start) == BOARD_SIZE + BOARD_SIZE))
+   if (move.get_moving_piece () != Piece::PAWN)
+      return;
+
+   int start = (int) move.from ();
+   int end = (int) move.to ();
+
+   // Turn the en-passant flag if necessary, on the square the pawn skipped
+   if ((end - start == 2 * PlayerTraits<side>::PAWN_STEP) &&
+       (this->chessmen.pawn->get_side_moves (end, side) & this->piece[opponent][Piece::PAWN]))
    {
-      int min = (start < end ? start : end);
-      int max = (start > end ? start : end);
-      int row = (this->is_whites_turn ? min : max);
-      int size = (this->is_whites_turn ? BOARD_SIZE : -((int)BOARD_SIZE));
+      int square = start + PlayerTraits<side>::PAWN_STEP;
 
-      this->en_passant_capture_square = util::Util::to_bitboard[row + size];
-      int square = util::Util::MSB_position (this->en_passant_capture_square);
+      this->en_passant_capture_square = util::Util::to_bitboard[square];
       this->hash_key ^= this->en_passant_key[square];
-      this->hash_lock ^= this->en_passant_key[square];
    }
 }
 
@@ -640,9 +1021,11 @@ MaeBoard::handle_en_passant_move (const Move& move)
   has moved to the corners of the board (possibly a rook has moved or has been
   captured by the enemy)
   ===========================================================================*/
+template <Piece::Player side>
 void
 MaeBoard::handle_castling_privileges (const Move& move)
 {
+   const Piece::Player opponent = PlayerTraits<side>::OPPONENT;
    ushort start = move.from ();
    ushort end = move.to ();
 
@@ -654,62 +1037,56 @@ MaeBoard::handle_castling_privileges (const Move& move)
       {
          add_piece (BoardSquare (end-1), board[end+1].piece, board[end+1].player);
          remove_piece (BoardSquare (end + 1));
-         this->is_castled_[player][KING_SIDE] = true;
+         this->is_castled_[side][KING_SIDE] = true;
       }
       else if (move.get_type () == Move::CASTLE_QUEEN_SIDE)
       {
          add_piece (BoardSquare (end+1), board[end-2].piece, board[end-2].player);
          remove_piece (BoardSquare (end - 2));
-         this->is_castled_[player][QUEEN_SIDE] = true;
+         this->is_castled_[side][QUEEN_SIDE] = true;
       }
-      this->can_do_castle[player][KING_SIDE] = false;
-      this->can_do_castle[player][QUEEN_SIDE] = false;
+      this->can_do_castle[side][KING_SIDE] = false;
+      this->can_do_castle[side][QUEEN_SIDE] = false;
 
-      // Update hash key and hash lock
-      this->hash_key ^= castle_key[player][KING_SIDE];
-      this->hash_key ^= castle_key[player][QUEEN_SIDE];
+      // Update hash key
+      this->hash_key ^= castle_key[side][KING_SIDE];
+      this->hash_key ^= castle_key[side][QUEEN_SIDE];
 
-      this->hash_lock ^= castle_key[player][KING_SIDE];
-      this->hash_lock ^= castle_key[player][QUEEN_SIDE];
    }
    // If anything moves from or to any of the board corners, castling is lost.
-   else if (start == this->corner[player][KING_SIDE])
+   else if (start == PlayerTraits<side>::KING_SIDE_CORNER)
    {
-      if (this->can_do_castle[player][KING_SIDE])
+      if (this->can_do_castle[side][KING_SIDE])
       {
-         // Update hash key and hash lock
-         this->hash_key ^= castle_key[player][KING_SIDE];
-         this->hash_lock ^= castle_key[player][KING_SIDE];
+         // Update hash key
+         this->hash_key ^= castle_key[side][KING_SIDE];
       }
-      this->can_do_castle[player][KING_SIDE] = false;
+      this->can_do_castle[side][KING_SIDE] = false;
    }
-   else if (start == this->corner[player][QUEEN_SIDE])
+   else if (start == PlayerTraits<side>::QUEEN_SIDE_CORNER)
    {
-      if (this->can_do_castle[player][QUEEN_SIDE])
+      if (this->can_do_castle[side][QUEEN_SIDE])
       {
-         // Update hash key and hash lock
-         this->hash_key ^= this->castle_key[player][QUEEN_SIDE];
-         this->hash_lock ^= this->castle_key[player][QUEEN_SIDE];
+         // Update hash key
+         this->hash_key ^= this->castle_key[side][QUEEN_SIDE];
       }
-      this->can_do_castle[player][QUEEN_SIDE] = false;
+      this->can_do_castle[side][QUEEN_SIDE] = false;
    }
-   else if (end == this->corner[opponent][KING_SIDE])
+   else if (end == PlayerTraits<opponent>::KING_SIDE_CORNER)
    {
-      if (this->can_do_castle[opponent][QUEEN_SIDE])
+      if (this->can_do_castle[opponent][KING_SIDE])
       {
-         // Update hash key and hash lock
+         // Update hash key
          this->hash_key ^= this->castle_key[opponent][KING_SIDE];
-         this->hash_lock ^= this->castle_key[opponent][KING_SIDE];
       }
       this->can_do_castle[opponent][KING_SIDE] = false;
    }
-   else if (end == this->corner[opponent][QUEEN_SIDE])
+   else if (end == PlayerTraits<opponent>::QUEEN_SIDE_CORNER)
    {
       if (this->can_do_castle[opponent][QUEEN_SIDE])
       {
-         // Update hash key and hash lock
+         // Update hash key
          this->hash_key ^= this->castle_key[opponent][QUEEN_SIDE];
-         this->hash_lock ^= this->castle_key[opponent][QUEEN_SIDE];
       }
       this->can_do_castle[opponent][QUEEN_SIDE] = false;
    }
@@ -732,18 +1109,26 @@ MaeBoard::handle_promotion_move (const Move& move)
 }
 
 /*=============================================================================
-  Create instances of Piece (Knight, Bishop, Queen, etc.) to aid in move
-  generation and checking whether moves are valid.
+  Point to the instances of Piece (Knight, Bishop, Queen, etc.) that aid in
+  move generation and checking whether moves are valid. Their tables are
+  computed once and never change, so every board shares the same instances.
   ===========================================================================*/
 void
 MaeBoard::load_chessmen ()
 {
-   this->chessmen[Piece::ROOK] = new Rook ();
-   this->chessmen[Piece::KNIGHT] = new Knight ();
-   this->chessmen[Piece::BISHOP] = new Bishop ();
-   this->chessmen[Piece::QUEEN] = new Queen ();
-   this->chessmen[Piece::KING] = new King ();
-   this->chessmen[Piece::PAWN] = new Pawn ();
+   static const Rook rook;
+   static const Knight knight;
+   static const Bishop bishop;
+   static const Queen queen;
+   static const King king;
+   static const Pawn pawn;
+
+   this->chessmen.rook = &rook;
+   this->chessmen.knight = &knight;
+   this->chessmen.bishop = &bishop;
+   this->chessmen.queen = &queen;
+   this->chessmen.king = &king;
+   this->chessmen.pawn = &pawn;
 }
 
 /*=============================================================================
@@ -795,9 +1180,8 @@ void
 MaeBoard::save_restore_information (const Move& move)
 {
    BoardConfiguration restore_information (
-       move, this->en_passant_capture_square,
-       this->can_do_castle[player][KING_SIDE], this->can_do_castle[player][QUEEN_SIDE],
-       this->hash_key, this->hash_lock);
+       move, this->en_passant_capture_square, this->can_do_castle,
+       this->fifty_move_counter, this->hash_key);
 
    this->game_history.push (restore_information);
 }
@@ -808,10 +1192,10 @@ MaeBoard::change_turn ()
    this->is_whites_turn = !this->is_whites_turn;
    this->opponent = this->player;
    this->player = (this->opponent == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
+   forget_attack_map ();
 
    // Update hash keys to reflect the turn
    this->hash_key ^= this->turn_key;
-   this->hash_lock ^= this->turn_key;
 }
 
 /*=============================================================================
@@ -821,49 +1205,7 @@ MaeBoard::change_turn ()
 bitboard
 MaeBoard::get_moves (Piece::Type piece, BoardSquare square) const
 {
-   return this->chessmen[piece]->get_moves (square, this->player, this);
-}
-
-bitboard
-MaeBoard::get_all_pieces () const
-{
-   return this->all_pieces;
-}
-
-bitboard
-MaeBoard::get_pieces (Piece::Player player) const
-{
-   return this->pieces[player];
-}
-
-bitboard
-MaeBoard::get_pieces (Piece::Player player, Piece::Type piece) const
-{
-   return this->piece[player][piece];
-}
-
-ullong
-MaeBoard::get_hash_key () const
-{
-   return this->hash_key;
-}
-
-ullong
-MaeBoard::get_hash_lock () const
-{
-   return this->hash_lock;
-}
-
-bool
-MaeBoard::is_en_passant_on () const
-{
-   return this->en_passant_capture_square != 0;
-}
-
-bool
-MaeBoard::can_castle (Piece::Player player, CastleSide side) const
-{
-   return this->can_do_castle[player][side];
+   return get_piece_moves (piece, square, this->player);
 }
 
 bool
@@ -872,36 +1214,12 @@ MaeBoard::is_castled (Piece::Player player, CastleSide side) const
    return this->is_castled_[player][side];
 }
 
-bitboard
-MaeBoard::get_en_passant_square () const
-{
-   return this->en_passant_capture_square;
-}
-
-BoardSquare
-MaeBoard::get_initial_king_square (Piece::Player player) const
-{
-   return this->original_king_position[player];
-}
-
 Piece::Player
 MaeBoard::get_piece_color (BoardSquare square) const
 {
    return this->board[square].player;
 }
 
-Piece::Player
-MaeBoard::get_player_in_turn () const
-{
-   return this->player;
-}
-
-Piece::Type
-MaeBoard::get_piece (BoardSquare square) const
-{
-   return this->board[square].piece;
-}
-
 uint
 MaeBoard::get_move_number () const
 {
@@ -920,7 +1238,7 @@ MaeBoard::get_move_number () const
 ushort
 MaeBoard::get_repetition_count () const
 {
-   BoardKey key = { this->hash_key, this->hash_lock };
+   BoardKey key = this->hash_key;
    return this->position_counter.get_repetitions (key);
 }
 
@@ -934,8 +1252,17 @@ MaeBoard::set_game_status (GameStatus status)
 void
 MaeBoard::set_en_passant_capture_square (BoardSquare en_passant_capture_square)
 {
+   // Keep the hash key in sync, as handle_en_passant_move does
+   if (this->en_passant_capture_square)
+   {
+      int square = util::Util::MSB_position (this->en_passant_capture_square);
+      this->hash_key ^= this->en_passant_key[square];
+   }
+
    this->en_passant_capture_square =
          util::Util::to_bitboard[en_passant_capture_square];
+
+   this->hash_key ^= this->en_passant_key[en_passant_capture_square];
 }
 
 void
@@ -944,12 +1271,12 @@ MaeBoard::set_player_in_turn (Piece::Player player)
    this->is_whites_turn = (player == Piece::WHITE ? true : false);
    this->player = player;
    this->opponent = (this->player == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
+   forget_attack_map ();
 
    // a hash key for the turn is added to the board key when it's black's turn
    if (!this->is_whites_turn)
    {
       this->hash_key ^= this->turn_key;
-      this->hash_lock ^= this->turn_key;
    }
 }
 
@@ -962,9 +1289,8 @@ MaeBoard::set_castling_privilege (
    // Whenever a side can no longer castle, a hash key is added to the board key
    if (this->can_do_castle[player][side] == false)
    {
-      // Update hash key and hash lock
+      // Update hash key
       this->hash_key ^= this->castle_key[player][side];
-      this->hash_lock ^= this->castle_key[player][side];
    }
 }
 
@@ -3,6 +3,7 @@
 
 #include "IBoard.hpp"
 #include "Square.hpp"
+#include "BoardState.hpp"
 #include "BoardConfiguration.hpp"
 #include "BoardConfigurationTracker.hpp"
 #include "GameTraits.hpp"
@@ -10,7 +11,19 @@
 
 namespace game_rules
 {
-class MaeBoard : public IBoard
+class Pawn;
+class Knight;
+class Bishop;
+class Rook;
+class Queen;
+class King;
+
+/*==============================================================================
+  The position itself lives in the BoardState base, so that it can be copied
+  on its own (see get_state and set_state), while the history of the game,
+  the repetition counter and the attack map cache stay with the board.
+  ==============================================================================*/
+class MaeBoard final : public IBoard, private BoardState
 {
   public:
    MaeBoard ();
@@ -22,6 +35,10 @@ class MaeBoard : public IBoard
 
    bool load_game (const std::string& file);
    bool save_game (const std::string& file);
+   bool load_fen (const std::string& fen);
+
+   const BoardState& get_state () const;
+   void set_state (const BoardState& state);
 
    bool add_piece (const std::string& location, Piece::Type type, Piece::Player);
    bool add_piece (BoardSquare square, Piece::Type, Piece::Player);
@@ -33,6 +50,8 @@ class MaeBoard : public IBoard
    bool undo_move ();
 
    void label_move (Move& move) const;
+   const AttackMap& get_attack_map () const;
+   bool gives_check (const Move& move) const;
 
    bool is_king_in_check () const;
    bitboard attacks_to (BoardSquare location, bool include_king) const;
@@ -54,7 +73,6 @@ class MaeBoard : public IBoard
    Piece::Player get_player_in_turn () const;
    Piece::Type get_piece (BoardSquare square) const;
    ullong get_hash_key () const;
-   ullong get_hash_lock () const;
    uint get_move_number () const;
    ushort get_repetition_count () const;
 
@@ -69,62 +87,147 @@ class MaeBoard : public IBoard
 
    static const uint CASTLE_SIDES_COUNT =  2;
    static const uint RANDOM_SEED  =  8;
-   static const uint HASH_KEYS_COUNT  =  2;
    static const Square EMPTY_SQUARE;
 
-   // Basic board representation
-   bitboard piece[PLAYERS_COUNT][PIECE_KINDS_COUNT];
-   bitboard pieces[PLAYERS_COUNT];
-   bitboard all_pieces;
-   Square board[BOARD_SQUARES_COUNT];
-
-   // Hash key information
-   ullong zobrist[PIECE_KINDS_COUNT][PLAYERS_COUNT][BOARD_SQUARES_COUNT][HASH_KEYS_COUNT];
-   ullong hash_key;
-   ullong hash_lock;
-   ullong turn_key;
-   ullong castle_key[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
-   ullong en_passant_key[BOARD_SQUARES_COUNT];
-
-   // Special moves information
-   bool can_do_castle[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
-   bool is_castled_[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
-   bitboard en_passant_capture_square;
-
-   // Turn information
-   bool is_whites_turn;
-   Piece::Player player, opponent;
+   // Keys the hash key is made of, shared by every board
+   static ullong zobrist[PIECE_KINDS_COUNT][PLAYERS_COUNT][BOARD_SQUARES_COUNT];
+   static ullong turn_key;
+   static ullong castle_key[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
+   static ullong en_passant_key[BOARD_SQUARES_COUNT];
+   static const bool zobrist_computed;
 
    // This information is intended to resume interrupted games
    GameStatus game_status;
 
+   // Attack information of the current position, worked out lazily, piece by
+   // piece (see the KNOWN_* flags), and forgotten as soon as it changes
+   enum AttackMapPart {
+      KNOWN_CHECKERS = 1,
+      KNOWN_PINNED = 2,
+      KNOWN_ATTACKS = 4,
+      KNOWN_CHECK_SQUARES = 8
+   };
+
+   mutable AttackMap attack_map;
+   mutable ushort known_attack_map_parts;
+
+   // Squares strictly between any two squares sharing a row, column or
+   // diagonal (empty for any other pair)
+   static bitboard squares_between[BOARD_SQUARES_COUNT][BOARD_SQUARES_COUNT];
+   static const bool squares_between_computed;
+
    // Useful to detect threefold repetition conditions
    BoardConfigurationTracker position_counter;
 
-   // Counter used to detect draws by the 50-move rule
-   uint fifty_move_counter;
-
    std::stack<BoardConfiguration> game_history;
-   Piece* chessmen[PIECE_KINDS_COUNT];
+
+   // The move rules of each kind of piece, called directly rather than
+   // through a common base (see get_piece_moves and get_piece_attacks)
+   struct Chessmen
+   {
+      const Pawn* pawn;
+      const Knight* knight;
+      const Bishop* bishop;
+      const Rook* rook;
+      const Queen* queen;
+      const King* king;
+   } chessmen;
 
    bitboard eighth_rank[PLAYERS_COUNT];
    BoardSquare corner[PLAYERS_COUNT][CASTLE_SIDES_COUNT];
    BoardSquare original_king_position[PLAYERS_COUNT];
 
-   void handle_en_passant_move (const Move&);
-   void handle_castling_privileges (const Move&);
+   // The rules that tell both sides apart, specialized on the SIDE that moves
+   template <Piece::Player side> Error make_move (Move& move, bool is_computer_move);
+   template <Piece::Player side> bool undo_move ();
+   template <Piece::Player side> void handle_en_passant_move (const Move&);
+   template <Piece::Player side> void handle_castling_privileges (const Move&);
    void handle_promotion_move (const Move&);
 
    Error can_move (const Move&) const;
 
+   bitboard get_piece_moves (Piece::Type, uint square, Piece::Player) const;
+   bitboard get_piece_attacks (Piece::Type, uint square, Piece::Player) const;
+
+   bitboard get_checkers () const;
+   bitboard get_pinned_pieces () const;
+   const AttackMap& get_check_squares () const;
+   bitboard get_blockers (Piece::Player king_side, Piece::Player slider_side) const;
+   bool is_attacked_by_sliders (
+       BoardSquare target, bitboard occupancy, bitboard diagonal_sliders, bitboard straight_sliders) const;
+   void forget_attack_map () { this->known_attack_map_parts = 0; }
+   static bool compute_squares_between ();
+   static bool compute_zobrist ();
+
    void load_chessmen ();
    void load_support_data ();
-   void load_zobrist ();
 
    void save_restore_information (const Move&);
    void change_turn ();
 };
 
+// Called all over move generation and evaluation, hence defined here so that
+// the callers that know their board is a MaeBoard get them inlined
+inline bitboard
+MaeBoard::get_all_pieces () const
+{
+   return this->all_pieces;
+}
+
+inline bitboard
+MaeBoard::get_pieces (Piece::Player player) const
+{
+   return this->pieces[player];
+}
+
+inline bitboard
+MaeBoard::get_pieces (Piece::Player player, Piece::Type piece) const
+{
+   return this->piece[player][piece];
+}
+
+inline ullong
+MaeBoard::get_hash_key () const
+{
+   return this->hash_key;
+}
+
+inline Piece::Player
+MaeBoard::get_player_in_turn () const
+{
+   return this->player;
+}
+
+inline Piece::Type
+MaeBoard::get_piece (BoardSquare square) const
+{
+   return this->board[square].piece;
+}
+
+inline bool
+MaeBoard::is_en_passant_on () const
+{
+   return this->en_passant_capture_square != 0;
+}
+
+inline bool
+MaeBoard::can_castle (Piece::Player player, CastleSide side) const
+{
+   return this->can_do_castle[player][side];
+}
+
+inline bitboard
+MaeBoard::get_en_passant_square () const
+{
+   return this->en_passant_capture_square;
+}
+
+inline BoardSquare
+MaeBoard::get_initial_king_square (Piece::Player player) const
+{
+   return this->original_king_position[player];
+}
+
 } // namespace game_rules
 
 #endif // MAE_BOARD_H
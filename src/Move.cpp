@@ -52,6 +52,19 @@ Move::Move (const Move& move)
    this->captured_piece = move.captured_piece;
 }
 
+Move&
+Move::operator = (const Move& move)
+{
+   this->score = move.score;
+   this->start = move.start;
+   this->end = move.end;
+   this->type = move.type;
+   this->moving_piece = move.moving_piece;
+   this->captured_piece = move.captured_piece;
+
+   return *this;
+}
+
 /*=============================================================================
   Create a move without specifying its type.
 
@@ -77,6 +90,26 @@ Move::is_null () const
    return this->type == NULL_MOVE;
 }
 
+/*=============================================================================
+  Return THIS move in coordinate notation (e.g. e2e4), as understood by
+  Xboard and by the constructor Move (const std::string&)
+  ============================================================================*/
+std::string
+Move::get_notation () const
+{
+   std::string initial, final;
+
+   translate_to_notation (this->start, initial);
+   translate_to_notation (this->end, final);
+
+   // Pawns are always promoted to queens (see MaeBoard::handle_promotion_move)
+   uint row = this->end / BOARD_SIZE;
+   if (this->moving_piece == Piece::PAWN && (row == 0 || row == BOARD_SIZE - 1))
+      final += "q";
+
+   return initial + final;
+}
+
 /*=============================================================================
   Output information regarding MOVE to the stream OUT
   ============================================================================*/
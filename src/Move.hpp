@@ -15,6 +15,8 @@ class Move
    Move (BoardSquare start, BoardSquare end);
    Move (const Move&);
 
+   Move& operator = (const Move&);
+
    enum Type {
       SIMPLE_MOVE,
       NORMAL_CAPTURE,
@@ -42,6 +44,7 @@ class Move
    int  get_score () const;
 
    bool is_null () const;
+   std::string get_notation () const;
 
    friend std::ostream& operator << (std::ostream& out, const Move& move);
 
@@ -1,8 +1,9 @@
 #include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 #include "Util.hpp"
 #include "Move.hpp"
+#include "Profiler.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -12,6 +13,7 @@ namespace game_engine
 using std::vector;
 
 using game_rules::IBoard;
+using game_rules::MaeBoard;
 using game_rules::Move;
 using game_rules::Piece;
 using game_rules::BoardSquare;
@@ -23,9 +25,12 @@ using util::bitboard;
   the list, sorted by the Most-Valuable-Victim Least-Valuable-Attacker
   ratio.
   ==========================================================================*/
+template <class Board>
 bool
-MoveGenerator::generate_moves (IBoard* board, vector<Move>&  moves)
+MoveGenerator::generate_moves (Board* board, vector<Move>&  moves)
 {
+   PROFILE_ZONE ("generate_moves");
+
    PositionEvaluator position_evaluator;
    vector<Move> captures;
    bitboard pieces;
@@ -58,8 +63,13 @@ MoveGenerator::generate_moves (IBoard* board, vector<Move>&  moves)
                 move_type == Move::EN_PASSANT_CAPTURE)
             {
                move.set_captured_piece (board->get_piece (current_move));
+
+               // The pawn captured en passant is not on the destination square
+               Piece::Type victim = (move_type == Move::EN_PASSANT_CAPTURE ?
+                                     Piece::PAWN : move.get_captured_piece ());
+
                double score = position_evaluator.get_piece_value (move.get_moving_piece ());
-               score /= position_evaluator.get_piece_value (move.get_captured_piece ());
+               score /= position_evaluator.get_piece_value (victim);
                move.set_score ((int)(10 * score));
                captures.push_back (move);
             }
@@ -82,10 +92,13 @@ MoveGenerator::generate_moves (IBoard* board, vector<Move>&  moves)
   Generate pseudo legal moves of the kinds contained in FLAGS, as opposed
   to simply generating all moves.
   ==========================================================================*/
+template <class Board>
 bool
 MoveGenerator::generate_moves (
-    IBoard* board, vector<Move>& moves, ushort kind_of_moves)
+    Board* board, vector<Move>& moves, ushort kind_of_moves)
 {
+   PROFILE_ZONE ("generate_moves");
+
    PositionEvaluator evaluator;
 
    vector<Move> promotions;
@@ -126,14 +139,23 @@ MoveGenerator::generate_moves (
 
                if (kind_of_moves & MoveGenerator::CAPTURES)
                {
+                  Piece::Type victim = (move_type == Move::EN_PASSANT_CAPTURE ?
+                                        Piece::PAWN : move.get_captured_piece ());
+
                   double score = evaluator.get_piece_value (move.get_moving_piece ());
-                  score /= evaluator.get_piece_value (move.get_captured_piece ());
+                  score /= evaluator.get_piece_value (victim);
                   move.set_score ((int)(10 * score));
                   captures.push_back (move);
                }
             }
 
-            if ((kind_of_moves & MoveGenerator::CHECKS) && move_type == Move::CHECK)
+            // Captures and promotions giving check are already listed
+            // above; moves are only known to give check by asking the board
+            if ((kind_of_moves & MoveGenerator::CHECKS) &&
+                (move_type == Move::SIMPLE_MOVE ||
+                 move_type == Move::CASTLE_KING_SIDE ||
+                 move_type == Move::CASTLE_QUEEN_SIDE) &&
+                board->gives_check (move))
                checks.push_back (move);
 
             if ((kind_of_moves & MoveGenerator::PAWN_PROMOTIONS) &&
@@ -153,11 +175,11 @@ MoveGenerator::generate_moves (
                if (error == IBoard::NO_ERROR)
                {
                   check_evasions.push_back (move);
-                  assert(board->undo_move());
+                  VERIFY (board->undo_move ());
                }
                else if (error == IBoard::DRAW_BY_REPETITION)
                {
-                  assert(board->undo_move());
+                  VERIFY (board->undo_move ());
                }
                else if (error != IBoard::KING_LEFT_IN_CHECK)
                {
@@ -193,8 +215,9 @@ MoveGenerator::generate_moves (
    return moves.size () != 0;
 }
 
+template <class Board>
 bool
-MoveGenerator::generate_en_prise_evations (IBoard* board, vector<Move>& moves)
+MoveGenerator::generate_en_prise_evations (Board* board, vector<Move>& moves)
 {
    Piece::Player player = board->get_player_in_turn ();
 
@@ -236,4 +259,78 @@ MoveGenerator::generate_en_prise_evations (IBoard* board, vector<Move>& moves)
    return moves.size () != 0;
 }
 
+/*==========================================================================
+  Whether a move gives check is worked out by the board before making it,
+  which is much cheaper than making every quiet move to find out
+  ==========================================================================*/
+template <class Board>
+bool
+MoveGenerator::generate_quiet_checks (Board* board, vector<Move>& moves)
+{
+   Piece::Player player = board->get_player_in_turn ();
+   bitboard empty_squares = ~board->get_all_pieces ();
+   uint first_check = moves.size ();
+
+   for (Piece::Type piece = Piece::PAWN; piece <= Piece::KING; ++piece)
+   {
+      bitboard pieces = board->get_pieces (player, piece);
+      while (pieces)
+      {
+         auto square = BoardSquare (util::Util::LSB_position (pieces));
+         bitboard valid_moves = board->get_moves (piece, square) & empty_squares;
+
+         while (valid_moves)
+         {
+            auto to = BoardSquare (util::Util::LSB_position (valid_moves));
+            Move move (square, to);
+            move.set_moving_piece (piece);
+            board->label_move (move);
+
+            if ((move.get_type () == Move::SIMPLE_MOVE ||
+                 move.get_type () == Move::CASTLE_KING_SIDE ||
+                 move.get_type () == Move::CASTLE_QUEEN_SIDE) &&
+                board->gives_check (move))
+            {
+               moves.push_back (move);
+            }
+            // Watch out! removing a bit this way only works for the LSB
+            valid_moves &= (valid_moves - 1);
+         }
+         // Watch out! removing a bit this way only works for the LSB
+         pieces &= (pieces - 1);
+      }
+   }
+
+   return moves.size () != first_check;
+}
+
+bool
+MoveGenerator::generate_moves (IBoard* board, vector<Move>& moves, ushort kind_of_moves)
+{
+   return generate_moves<IBoard> (board, moves, kind_of_moves);
+}
+
+bool
+MoveGenerator::generate_moves (IBoard* board, vector<Move>& moves)
+{
+   return generate_moves<IBoard> (board, moves);
+}
+
+bool
+MoveGenerator::generate_en_prise_evations (IBoard* board, vector<Move>& moves)
+{
+   return generate_en_prise_evations<IBoard> (board, moves);
+}
+
+bool
+MoveGenerator::generate_quiet_checks (IBoard* board, vector<Move>& moves)
+{
+   return generate_quiet_checks<IBoard> (board, moves);
+}
+
+template bool MoveGenerator::generate_moves<MaeBoard> (MaeBoard*, vector<Move>&, ushort);
+template bool MoveGenerator::generate_moves<MaeBoard> (MaeBoard*, vector<Move>&);
+template bool MoveGenerator::generate_en_prise_evations<MaeBoard> (MaeBoard*, vector<Move>&);
+template bool MoveGenerator::generate_quiet_checks<MaeBoard> (MaeBoard*, vector<Move>&);
+
 } // namespace game_engine
@@ -5,7 +5,7 @@
 
 namespace game_engine
 {
-class MoveGenerator : public IMoveGenerator
+class MoveGenerator final : public IMoveGenerator
 {
   public:
    /*======================================================================
@@ -14,6 +14,16 @@ class MoveGenerator : public IMoveGenerator
    bool generate_moves (game_rules::IBoard*, std::vector<game_rules::Move>& moves, ushort kind_of_moves);
    bool generate_moves (game_rules::IBoard*, std::vector<game_rules::Move>& moves);
    bool generate_en_prise_evations (game_rules::IBoard*, std::vector<game_rules::Move>& moves);
+   bool generate_quiet_checks (game_rules::IBoard*, std::vector<game_rules::Move>& moves);
+
+   template <class Board>
+   bool generate_moves (Board*, std::vector<game_rules::Move>& moves, ushort kind_of_moves);
+   template <class Board>
+   bool generate_moves (Board*, std::vector<game_rules::Move>& moves);
+   template <class Board>
+   bool generate_en_prise_evations (Board*, std::vector<game_rules::Move>& moves);
+   template <class Board>
+   bool generate_quiet_checks (Board*, std::vector<game_rules::Move>& moves);
 };
 
 } // namespace game_engine
@@ -1,12 +1,15 @@
 #include "Pawn.hpp"
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 
 namespace game_rules
 {
-Pawn::Pawn ()
-{
-   compute_moves ();
-}
+const bool Pawn::moves_computed = Pawn::compute_moves ();
+bitboard Pawn::moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+bitboard Pawn::simple_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+bitboard Pawn::capture_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT][PAWN_CAPTURE_MOVES_COUNT];
+bitboard Pawn::side_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+
+Pawn::Pawn () { }
 
 Pawn::~Pawn () { }
 
@@ -15,53 +18,71 @@ Pawn::~Pawn () { }
   PLAYER's turn to move (moves that leave the king in check are also included)
   ============================================================================*/
 bitboard
-Pawn::get_moves (uint square, Player player, const IBoard* board) const
+Pawn::get_moves (uint square, Player player, const MaeBoard* board) const
 {
-   Piece::Player opponent = WHITE;
-
    if (!IBoard::is_inside_board (square))
       return 0;
 
    if (player == WHITE)
-      opponent = BLACK;
+      return get_moves<WHITE> (square, board);
+
+   return get_moves<BLACK> (square, board);
+}
+
+/*============================================================================
+  Same as above, with the side to move (and so the direction pawns go, and
+  the row they can make a two-square move from) fixed at compile time
+  ============================================================================*/
+template <Piece::Player player>
+bitboard
+Pawn::get_moves (uint square, const MaeBoard* board) const
+{
+   const Player opponent = PlayerTraits<player>::OPPONENT;
 
    bitboard all_pieces = board->get_all_pieces ();
    bitboard opponent_pieces = board->get_pieces (opponent);
-   bitboard opponent_pawns = board->get_pieces (opponent, PAWN);
 
-   bitboard east_capture = get_capture_move (square, player, Piece::EAST);
-   bitboard west_capture = get_capture_move (square, player, Piece::WEST);
-   bitboard captures = east_capture | west_capture;
+   bitboard captures = this->capture_moves_from[square][player][0] |
+                       this->capture_moves_from[square][player][1];
 
-   bitboard simple_moves = simple_moves_from [square][player];
+   bitboard simple_moves = this->simple_moves_from[square][player];
    bitboard moves = (captures & opponent_pieces) | (simple_moves & ~all_pieces);
-   bitboard double_move = get_double_move (square, player);
 
-   // Is there a two-square move included already ? [*]
-   if ((moves & double_move) &&
-       // If there is a piece in the way to making a two-square move, you
-       // must discard that move
-       (simple_moves ^ double_move) & all_pieces)
+   // If there is a piece in the way to making a two-square move, you must
+   // discard that move
+   if (get_row (square) == PlayerTraits<player>::PAWN_SECOND_ROW)
    {
-      // [*] Failing to check this will only add an invalid move to the set
-      moves ^= double_move;
+      bitboard double_move =
+            util::constants::ONE << (square + 2 * PlayerTraits<player>::PAWN_STEP);
+
+      if ((moves & double_move) && ((simple_moves ^ double_move) & all_pieces))
+         moves ^= double_move;
    }
 
    // Add possible en-passant captures
-   if (board->is_en_passant_on () && (get_side_moves (square, player) & opponent_pawns))
+   if (board->is_en_passant_on () &&
+       (this->side_moves_from[square][player] & board->get_pieces (opponent, PAWN)))
    {
-      bitboard en_passant_capture_square = board->get_en_passant_square ();
-
-      if (west_capture & en_passant_capture_square)
-         moves |= en_passant_capture_square;
-
-      else if (east_capture & en_passant_capture_square)
-         moves |= en_passant_capture_square;
+      moves |= captures & board->get_en_passant_square ();
    }
 
    return moves;
 }
 
+/*=============================================================================
+  A pawn attacks the squares it could capture on, whether there is a piece
+  there or not, but never the square in front of it
+  ============================================================================*/
+bitboard
+Pawn::get_attacks (uint square, Player player, const MaeBoard* /* board */) const
+{
+   if (!IBoard::is_inside_board (square))
+      return 0;
+
+   return (this->capture_moves_from[square][player][0] |
+           this->capture_moves_from[square][player][1]);
+}
+
 /*=============================================================================
   Return all possible moves from SQUARE, assuming the board is empty.
   ============================================================================*/
@@ -146,7 +167,7 @@ Pawn::get_side_moves (uint square, Player player) const
   Compute all moves a pawn can make from every square on the board assuming
   the board is empty. Moves are computed for both WHITE and BLACK pawns.
   =============================================================================*/
-void
+bool
 Pawn::compute_moves ()
 {
    for (uint row = 0; row < BOARD_SIZE; ++row)
@@ -156,31 +177,33 @@ Pawn::compute_moves ()
 
          for (Player player = WHITE; player <= BLACK; ++player)
          {
-            this->side_moves_from[square][player] = compute_side_moves (square, player);
-            this->moves_from[square][player] = 0;
+            side_moves_from[square][player] = compute_side_moves (square, player);
+            moves_from[square][player] = 0;
 
-            this->simple_moves_from[square][player] =
+            simple_moves_from[square][player] =
                   compute_simple_moves (square, player);
 
-            this->capture_moves_from[square][player][0] =
+            capture_moves_from[square][player][0] =
                   compute_capture_move (square, player, EAST);
 
-            this->capture_moves_from[square][player][1] =
+            capture_moves_from[square][player][1] =
                   compute_capture_move (square, player, WEST);
 
             // OR simple and capture moves into general moves
-            this->moves_from[square][player] |= this->simple_moves_from[square][player];
+            moves_from[square][player] |= simple_moves_from[square][player];
 
-            this->moves_from[square][player] |=
-                  this->capture_moves_from[square][player][0];
+            moves_from[square][player] |=
+                  capture_moves_from[square][player][0];
 
-            this->moves_from[square][player] |=
-                  this->capture_moves_from[square][player][1];
+            moves_from[square][player] |=
+                  capture_moves_from[square][player][1];
 
             // If potential moves include side moves then:
             // moves_from[square][player] |= side_moves_from[square];
          }
       }
+
+   return true;
 }
 
 /*=============================================================================
@@ -188,7 +211,7 @@ Pawn::compute_moves ()
   SQUARE
   =============================================================================*/
 bitboard
-Pawn::compute_side_moves (uint square, Player player) const
+Pawn::compute_side_moves (uint square, Player player)
 {
    bitboard side_moves = 0;
    int dx[PAWN_MOVES_COUNT - 1] = { -1, +1 };
@@ -210,7 +233,7 @@ Pawn::compute_side_moves (uint square, Player player) const
   pawn on SQUARE, assuming it is PLAYER'S turn to move.
   =============================================================================*/
 bitboard
-Pawn::compute_capture_move (uint square, Player player, RowColumn direction) const
+Pawn::compute_capture_move (uint square, Player player, RowColumn direction)
 {
    if (direction != EAST && direction != WEST)
       return 0;
@@ -237,7 +260,7 @@ Pawn::compute_capture_move (uint square, Player player, RowColumn direction) con
   assumming it is PLAYER's turn to move.
   =============================================================================*/
 bitboard
-Pawn::compute_simple_moves (uint square, Player player) const
+Pawn::compute_simple_moves (uint square, Player player)
 {
    bitboard simple_moves = 0;
    int dy[PAWN_MOVES_COUNT - 1] = { +1, +2 };
@@ -263,7 +286,7 @@ Pawn::compute_simple_moves (uint square, Player player) const
   otherwise.
   =============================================================================*/
 bool
-Pawn::is_second_row (uint row, Player player) const
+Pawn::is_second_row (uint row, Player player)
 {
    if (player == WHITE)
       return row == BOARD_SIZE - 2;
@@ -276,7 +299,7 @@ Pawn::is_second_row (uint row, Player player) const
   Precondition: SQUARE is in [0, BOARD_SQUARES_COUNT)
   =============================================================================*/
 uint
-Pawn::get_row (uint square) const
+Pawn::get_row (uint square)
 {
    return (square / BOARD_SIZE);
 }
@@ -286,7 +309,7 @@ Pawn::get_row (uint square) const
   Precondition: SQUARE is in [0, BOARD_SQUARES_COUNT)
   =============================================================================*/
 uint
-Pawn::get_column (uint square) const
+Pawn::get_column (uint square)
 {
    return square % BOARD_SIZE;
 }
@@ -295,7 +318,7 @@ Pawn::get_column (uint square) const
   Return TRUE if a pawn of side COLOR can be on ROW; return FALSE otherwise.
   =============================================================================*/
 bool
-Pawn::is_valid_row (uint row, Player color) const
+Pawn::is_valid_row (uint row, Player color)
 {
    if (color == WHITE)
       return row != BOARD_SIZE - 1;
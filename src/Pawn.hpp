@@ -12,15 +12,16 @@
 
 namespace game_rules
 {
-class IBoard;
+class MaeBoard;
 
-class Pawn : public Piece
+class Pawn final : public Piece
 {
   public:
    Pawn ();
    ~Pawn ();
 
-   bitboard get_moves (uint square, Player player, const IBoard* board) const;
+   bitboard get_moves (uint square, Player player, const MaeBoard* board) const;
+   bitboard get_attacks (uint square, Player player, const MaeBoard* board) const;
 
    bitboard get_side_moves (uint square, Player player) const;
    bitboard get_double_move (uint square, Player player) const;
@@ -30,24 +31,29 @@ class Pawn : public Piece
 
   private:
 
+   template <Player player>
+   bitboard get_moves (uint square, const MaeBoard* board) const;
+
    bitboard get_simple_moves (uint square, Player player) const;
 
-   void compute_moves ();
-   bitboard compute_simple_moves (uint square, Player player) const;
-   bitboard compute_side_moves (uint square, Player player) const;
-   bitboard compute_capture_move (uint square, Player player, RowColumn direction) const;
+   static bool compute_moves ();
+   static bitboard compute_simple_moves (uint square, Player player);
+   static bitboard compute_side_moves (uint square, Player player);
+   static bitboard compute_capture_move (uint square, Player player, RowColumn direction);
 
-   bool is_second_row (uint row, Player player) const;
-   bool is_valid_row (uint row, Player player) const;
-   uint get_row (uint square) const;
-   uint get_column (uint square) const;
+   static bool is_second_row (uint row, Player player);
+   static bool is_valid_row (uint row, Player player);
+   static uint get_row (uint square);
+   static uint get_column (uint square);
 
-   bitboard moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
-   bitboard simple_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
-   bitboard capture_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT][PAWN_CAPTURE_MOVES_COUNT];
+   // Computed once, and shared by every board
+   static bitboard moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+   static bitboard simple_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+   static bitboard capture_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT][PAWN_CAPTURE_MOVES_COUNT];
 
    // These are not real moves, but they are useful for en-passant handling
-   bitboard side_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+   static bitboard side_moves_from[BOARD_SQUARES_COUNT][PLAYERS_COUNT];
+   static const bool moves_computed;
 };
 
 } // namespace game_rules
@@ -0,0 +1,172 @@
+#include "PerfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace diagnostics
+{
+PerfCounters::Reading::Reading ()
+{
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+   {
+      this->count[i] = 0;
+      this->is_counted[i] = false;
+   }
+}
+
+void
+PerfCounters::Reading::add (const Reading& other)
+{
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+   {
+      this->count[i] += other.count[i];
+      this->is_counted[i] = this->is_counted[i] || other.is_counted[i];
+   }
+}
+
+double
+PerfCounters::Reading::ratio (Event numerator, Event denominator) const
+{
+   if (!this->is_counted[numerator] || !this->is_counted[denominator] ||
+       this->count[denominator] == 0)
+   {
+      return -1.0;
+   }
+
+   return (double) this->count[numerator] / this->count[denominator];
+}
+
+#ifdef __linux__
+
+namespace
+{
+struct EventCode
+{
+   uint type;
+   ullong config;
+};
+
+const ullong L1D_READ = PERF_COUNT_HW_CACHE_L1D |
+                        (PERF_COUNT_HW_CACHE_OP_READ << 8);
+
+// In the order of PerfCounters::Event
+const EventCode event_codes[PerfCounters::EVENTS_COUNT] = {
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+   { PERF_TYPE_HW_CACHE, L1D_READ | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16) },
+   { PERF_TYPE_HW_CACHE, L1D_READ | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES }
+};
+}
+
+/*==============================================================================
+  Open the events for the calling thread, all of them stopped, with the
+  cycles leading the group
+  ==============================================================================*/
+PerfCounters::PerfCounters ()
+{
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+   {
+      perf_event_attr attributes;
+      std::memset (&attributes, 0, sizeof (attributes));
+
+      attributes.size = sizeof (attributes);
+      attributes.type = event_codes[i].type;
+      attributes.config = event_codes[i].config;
+      attributes.disabled = (i == CYCLES);   // The group starts along with its leader
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      int group = (i == CYCLES ? -1 : this->descriptors[CYCLES]);
+      if (i != CYCLES && group == -1)
+      {
+         this->descriptors[i] = -1;
+         continue;
+      }
+
+      this->descriptors[i] = syscall (
+          __NR_perf_event_open, &attributes, 0 /* this thread */, -1 /* any CPU */, group, 0);
+   }
+}
+
+PerfCounters::~PerfCounters ()
+{
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+      if (this->descriptors[i] != -1)
+         close (this->descriptors[i]);
+}
+
+bool
+PerfCounters::is_available () const
+{
+   return this->descriptors[CYCLES] != -1;
+}
+
+void
+PerfCounters::start ()
+{
+   if (!is_available ())
+      return;
+
+   ioctl (this->descriptors[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+   ioctl (this->descriptors[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/*==============================================================================
+  Stop counting and return the events counted since start (). Counts are
+  scaled up when the event was not on the processor all the time.
+  ==============================================================================*/
+PerfCounters::Reading
+PerfCounters::stop ()
+{
+   Reading reading;
+
+   if (!is_available ())
+      return reading;
+
+   ioctl (this->descriptors[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+   {
+      ullong values[3];   // Count, time enabled and time running
+
+      if (this->descriptors[i] == -1 ||
+          read (this->descriptors[i], values, sizeof (values)) != sizeof (values) ||
+          values[2] == 0)
+      {
+         continue;
+      }
+
+      reading.count[i] = (ullong) ((double) values[0] * values[1] / values[2]);
+      reading.is_counted[i] = true;
+   }
+
+   return reading;
+}
+
+#else
+
+PerfCounters::PerfCounters ()
+{
+   for (uint i = 0; i < EVENTS_COUNT; ++i)
+      this->descriptors[i] = -1;
+}
+
+PerfCounters::~PerfCounters () {}
+
+bool PerfCounters::is_available () const { return false; }
+void PerfCounters::start () {}
+PerfCounters::Reading PerfCounters::stop () { return Reading (); }
+
+#endif // __linux__
+
+} // namespace diagnostics
@@ -0,0 +1,69 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/*==============================================================================
+  Counts hardware events (cycles, instructions, branch misses, L1 data cache
+  and last level cache misses) of the calling thread through Linux's
+  perf_event_open, so that a change can be judged by the memory stalls and
+  mispredictions it saved and not only by the time it took.
+
+  The events are opened as a group, so that they are all counted over the
+  same time even when the processor has to multiplex its counters. Events the
+  processor (or the kernel, see /proc/sys/kernel/perf_event_paranoid) does not
+  allow are simply not counted; elsewhere than on Linux, none is.
+  ==============================================================================*/
+
+#include "Util.hpp"
+
+namespace diagnostics
+{
+class PerfCounters
+{
+  public:
+   enum Event {
+      CYCLES,
+      INSTRUCTIONS,
+      BRANCHES,
+      BRANCH_MISSES,
+      L1D_ACCESSES,
+      L1D_MISSES,
+      LLC_ACCESSES,
+      LLC_MISSES,
+      EVENTS_COUNT
+   };
+
+   struct Reading
+   {
+      ullong count[EVENTS_COUNT];
+      bool is_counted[EVENTS_COUNT];
+
+      Reading ();
+      void add (const Reading& other);
+
+      // Ratios of two events, or a negative number if any was not counted
+      double ratio (Event numerator, Event denominator) const;
+
+      double instructions_per_cycle () const { return ratio (INSTRUCTIONS, CYCLES); }
+      double branch_miss_rate () const { return ratio (BRANCH_MISSES, BRANCHES); }
+      double l1d_miss_rate () const { return ratio (L1D_MISSES, L1D_ACCESSES); }
+      double llc_miss_rate () const { return ratio (LLC_MISSES, LLC_ACCESSES); }
+   };
+
+   PerfCounters ();
+   ~PerfCounters ();
+
+   PerfCounters (const PerfCounters&) = delete;
+   PerfCounters& operator = (const PerfCounters&) = delete;
+
+   bool is_available () const;
+
+   void start ();
+   Reading stop ();
+
+  private:
+   int descriptors[EVENTS_COUNT];
+};
+
+} // namespace diagnostics
+
+#endif // PERF_COUNTERS_H
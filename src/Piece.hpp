@@ -3,24 +3,25 @@
 
 /*==============================================================================
   Base class for different pieces of the game, each one responsible for their
-  own move rules
+  own move rules. The kinds of piece share no interface through this class:
+  MaeBoard, their only client, calls each of them directly, so that their
+  move rules get inlined in move generation instead of dispatched by type.
  ==============================================================================*/
 
 #include "Util.hpp"
+#include "GameTraits.hpp"
+#include "BoardTraits.hpp"
 #include <string>
 
 namespace game_rules
 {
 using util::bitboard;
 
-// Cannot include IBoard.h because that creates a cyclic dependency
-class IBoard;
-
 class Piece
 {
 public:
    Piece () { }
-   virtual ~Piece () { }
+   ~Piece () { }
 
    static const uint PIECES_COUNT = 6;
 
@@ -39,7 +40,7 @@ public:
    // Number of capture moves a pawn can do (assuming there are pieces to capture)
    static const uint PAWN_CAPTURE_MOVES_COUNT = 2;
 
-   enum Type {
+   enum Type : unsigned char {
       PAWN,
       KNIGHT,
       BISHOP,
@@ -49,7 +50,7 @@ public:
       NULL_PIECE
    };
 
-   enum Player {
+   enum Player : unsigned char {
       WHITE,
       BLACK,
       NULL_PLAYER
@@ -72,11 +73,29 @@ public:
    };
 
    static std::string pieceString (Type piece_type);
+};
+
+/*==============================================================================
+  What sets both sides apart on the board. Code specialized on PLAYER (see
+  Pawn::get_moves and MaeBoard::make_move) gets these as constants, instead of
+  branching on the player in turn.
+  ==============================================================================*/
+template <Piece::Player player>
+struct PlayerTraits
+{
+   static constexpr Piece::Player OPPONENT =
+         (player == Piece::WHITE ? Piece::BLACK : Piece::WHITE);
+
+   // Square offset of a single pawn step (white pawns go towards the eighth
+   // row, which holds the lowest squares)
+   static constexpr int PAWN_STEP =
+         (player == Piece::WHITE ? -(int) BOARD_SIZE : (int) BOARD_SIZE);
 
-   virtual bitboard get_moves (
-       uint square, Player player, const IBoard* board) const = 0;
+   // Row pawns start on, and can make a two-square move from
+   static constexpr uint PAWN_SECOND_ROW = (player == Piece::WHITE ? BOARD_SIZE - 2 : 1);
 
-   virtual bitboard get_potential_moves (uint  square, Player player) const = 0;
+   static constexpr BoardSquare KING_SIDE_CORNER = (player == Piece::WHITE ? h1 : h8);
+   static constexpr BoardSquare QUEEN_SIDE_CORNER = (player == Piece::WHITE ? a1 : a8);
 };
 
 inline Piece::Diagonal&
@@ -1,14 +1,17 @@
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 #include "PositionEvaluator.hpp"
 #include "King.hpp"
 #include "Util.hpp"
 #include "GameTraits.hpp"
 #include "BoardTraits.hpp"
+#include "Profiler.hpp"
 #include <iostream>
+#include <cstdlib>
 
 namespace game_engine
 {
 using game_rules::IBoard;
+using game_rules::MaeBoard;
 using game_rules::Piece;
 using game_rules::BoardSquare;
 using game_rules::CastleSide;
@@ -30,30 +33,71 @@ PositionEvaluator::PositionEvaluator ()
    this->factor_weight.push_back (780); // MOBILITY
    this->factor_weight.push_back (916); // CENTER_CONTROL
    this->factor_weight.push_back (22); // KING_SAFETY
+
+   update_lazy_evaluation_margin ();
 }
 
+template <class Board>
 int
-PositionEvaluator::static_evaluation (const IBoard* board) const
+PositionEvaluator::static_evaluation (const Board* board) const
 {
+   PROFILE_ZONE ("static_evaluation");
+
    int material;
-   int mobility;
-   int king_safety = 0;
-   int center_control;
    int sign = (board->get_player_in_turn () == Piece::WHITE ? 1 : -1);
 
-   material = evaluate_material (board);
-   mobility = evaluate_mobility (board);
-   center_control = evaluate_center_control (board);
-   king_safety = evaluate_king_safety (board);
+   material = factor_weight[MATERIAL] * evaluate_material (board);
 
-   return sign * (factor_weight[MATERIAL] * material +
-                  factor_weight[MOBILITY] * mobility +
-                  factor_weight[CENTER_CONTROL] * center_control +
-                  factor_weight[KING_SAFETY] * king_safety);
+   return sign * (material + positional_value (board));
 }
 
+/*==============================================================================
+  Return the same value as static_evaluation, unless the material balance alone
+  is so far outside the window (ALPHA, BETA) that no positional term could bring
+  the score back inside it. In that case only the material part is returned,
+  saving the (much more expensive) mobility and center control computations.
+  How far is far enough follows from the bounds on each positional term and
+  their current weights, so the result is on the same side of the window as
+  static_evaluation whatever weights were loaded.
+
+  ALPHA and BETA are given from the point of view of the player in turn.
+  ==============================================================================*/
+template <class Board>
 int
-PositionEvaluator::evaluate_material (const IBoard* board) const
+PositionEvaluator::lazy_evaluation (const Board* board, int alpha, int beta) const
+{
+   int material;
+   int margin = this->lazy_evaluation_margin;
+   int sign = (board->get_player_in_turn () == Piece::WHITE ? 1 : -1);
+
+   material = sign * factor_weight[MATERIAL] * evaluate_material (board);
+
+   if (material + margin <= alpha || material - margin >= beta)
+      return material;
+
+   return material + sign * positional_value (board);
+}
+
+/*==============================================================================
+  Return the weighted sum of all the non-material factors of the evaluation,
+  from white's point of view.
+  ==============================================================================*/
+template <class Board>
+int
+PositionEvaluator::positional_value (const Board* board) const
+{
+   int mobility = evaluate_mobility (board);
+   int center_control = evaluate_center_control (board);
+   int king_safety = evaluate_king_safety (board);
+
+   return (factor_weight[MOBILITY] * mobility +
+           factor_weight[CENTER_CONTROL] * center_control +
+           factor_weight[KING_SAFETY] * king_safety);
+}
+
+template <class Board>
+int
+PositionEvaluator::evaluate_material (const Board* board) const
 {
    bitboard player_piece;
    bitboard opponent_piece;
@@ -70,8 +114,9 @@ PositionEvaluator::evaluate_material (const IBoard* board) const
    return material;
 }
 
+template <class Board>
 int
-PositionEvaluator::evaluate_mobility (const IBoard* board) const
+PositionEvaluator::evaluate_mobility (const Board* board) const
 {
    bitboard player_piece;
    bitboard opponent_piece;
@@ -88,8 +133,9 @@ PositionEvaluator::evaluate_mobility (const IBoard* board) const
    return mobility;
 }
 
+template <class Board>
 int
-PositionEvaluator::evaluate_center_control (const IBoard* board) const
+PositionEvaluator::evaluate_center_control (const Board* board) const
 {
    bitboard player_piece;
    bitboard opponent_piece;
@@ -106,8 +152,9 @@ PositionEvaluator::evaluate_center_control (const IBoard* board) const
    return center_control;
 }
 
+template <class Board>
 int
-PositionEvaluator::evaluate_king_safety (const IBoard* board) const
+PositionEvaluator::evaluate_king_safety (const Board* board) const
 {
    return (king_safety_value (board, Piece::WHITE) -
            king_safety_value (board, Piece::BLACK));
@@ -119,9 +166,10 @@ PositionEvaluator::material_value (bitboard piece, Piece::Type piece_type) const
    return util::Util::count_set_bits (piece) * piece_value[piece_type];
 }
 
+template <class Board>
 int
 PositionEvaluator::mobility_value (
-    const IBoard* board, bitboard piece, Piece::Type  piece_type) const
+    const Board* board, bitboard piece, Piece::Type  piece_type) const
 {
    bitboard moves = 0;
    uint n_moves = 0;
@@ -141,9 +189,10 @@ PositionEvaluator::mobility_value (
    return n_moves;
 }
 
+template <class Board>
 int
 PositionEvaluator::center_control_value (
-    const IBoard* board, bitboard piece, Piece::Type  piece_type) const
+    const Board* board, bitboard piece, Piece::Type  piece_type) const
 {
    bitboard center =
          (util::constants::ONE << 27) |
@@ -168,9 +217,10 @@ PositionEvaluator::center_control_value (
    return squares_controled;
 }
 
+template <class Board>
 int
 PositionEvaluator::king_safety_value (
-    const IBoard* board, Piece::Player player) const
+    const Board* board, Piece::Player player) const
 {
    static bitboard pawns[game_rules::PLAYERS_COUNT][game_rules::PLAYERS_COUNT] =
          {
@@ -238,6 +288,12 @@ PositionEvaluator::get_piece_value (Piece::Type piece_type) const
    return this->piece_value[piece_type];
 }
 
+int
+PositionEvaluator::get_material_weight () const
+{
+   return this->factor_weight[MATERIAL];
+}
+
 void
 PositionEvaluator::load_factor_weights (std::vector<int>& weights)
 {
@@ -248,6 +304,60 @@ PositionEvaluator::load_factor_weights (std::vector<int>& weights)
 
       this->factor_weight[i] = weights[i];
    }
+
+   update_lazy_evaluation_margin ();
+}
+
+void
+PositionEvaluator::update_lazy_evaluation_margin ()
+{
+   this->lazy_evaluation_margin =
+         MAX_MOBILITY * std::abs (factor_weight[MOBILITY]) +
+         MAX_CENTER_CONTROL * std::abs (factor_weight[CENTER_CONTROL]) +
+         MAX_KING_SAFETY * std::abs (factor_weight[KING_SAFETY]);
 }
 
+int
+PositionEvaluator::static_evaluation (const IBoard* board) const
+{
+   return static_evaluation<IBoard> (board);
+}
+
+int
+PositionEvaluator::lazy_evaluation (const IBoard* board, int alpha, int beta) const
+{
+   return lazy_evaluation<IBoard> (board, alpha, beta);
+}
+
+int
+PositionEvaluator::evaluate_material (const IBoard* board) const
+{
+   return evaluate_material<IBoard> (board);
+}
+
+int
+PositionEvaluator::evaluate_mobility (const IBoard* board) const
+{
+   return evaluate_mobility<IBoard> (board);
+}
+
+int
+PositionEvaluator::evaluate_center_control (const IBoard* board) const
+{
+   return evaluate_center_control<IBoard> (board);
+}
+
+int
+PositionEvaluator::evaluate_king_safety (const IBoard* board) const
+{
+   return evaluate_king_safety<IBoard> (board);
+}
+
+template int PositionEvaluator::static_evaluation<MaeBoard> (const MaeBoard*) const;
+template int PositionEvaluator::lazy_evaluation<MaeBoard> (const MaeBoard*, int, int) const;
+template int PositionEvaluator::evaluate_material<MaeBoard> (const MaeBoard*) const;
+template int PositionEvaluator::evaluate_mobility<MaeBoard> (const MaeBoard*) const;
+template int PositionEvaluator::evaluate_center_control<MaeBoard> (const MaeBoard*) const;
+template int PositionEvaluator::evaluate_king_safety<MaeBoard> (const MaeBoard*) const;
+
 } // namespace game_engine
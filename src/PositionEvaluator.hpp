@@ -8,28 +8,49 @@
 
 namespace game_engine
 {
-class PositionEvaluator : public IPositionEvaluator
+class PositionEvaluator final : public IPositionEvaluator
 {
   public:
    PositionEvaluator ();
    int static_evaluation (const game_rules::IBoard*) const;
+   int lazy_evaluation (const game_rules::IBoard*, int alpha, int beta) const;
    int evaluate_material (const game_rules::IBoard*) const;
    int evaluate_mobility (const game_rules::IBoard*) const;
    int evaluate_center_control (const game_rules::IBoard*) const;
    int evaluate_king_safety (const game_rules::IBoard*) const;
 
+   template <class Board> int static_evaluation (const Board*) const;
+   template <class Board> int lazy_evaluation (const Board*, int alpha, int beta) const;
+   template <class Board> int evaluate_material (const Board*) const;
+   template <class Board> int evaluate_mobility (const Board*) const;
+   template <class Board> int evaluate_center_control (const Board*) const;
+   template <class Board> int evaluate_king_safety (const Board*) const;
+
    int get_piece_value (game_rules::Piece::Type) const;
+   int get_material_weight () const;
    void load_factor_weights (std::vector<int>& weights);
 
+   // How far each positional term (see positional_value) can be from zero:
+   // nine queens and every other piece free to move, every piece on or
+   // attacking the four center squares, and the best against the worst
+   // king safety
+   static const int MAX_MOBILITY = 9 * 27 + 2 * 14 + 2 * 13 + 2 * 8;
+   static const int MAX_CENTER_CONTROL = 4 + 15 * 4;
+   static const int MAX_KING_SAFETY = 20 + 50;
+
   private:
+   template <class Board> int positional_value (const Board*) const;
+   void update_lazy_evaluation_margin ();
    int material_value (util::bitboard piece, game_rules::Piece::Type) const;
-   int mobility_value (
-       const game_rules::IBoard*, util::bitboard piece, game_rules::Piece::Type) const;
 
-   int center_control_value (
-       const game_rules::IBoard*, util::bitboard piece, game_rules::Piece::Type) const;
+   template <class Board>
+   int mobility_value (const Board*, util::bitboard piece, game_rules::Piece::Type) const;
 
-   int king_safety_value (const game_rules::IBoard*, game_rules::Piece::Player) const;
+   template <class Board>
+   int center_control_value (const Board*, util::bitboard piece, game_rules::Piece::Type) const;
+
+   template <class Board>
+   int king_safety_value (const Board*, game_rules::Piece::Player) const;
    int development_value (const game_rules::IBoard*, game_rules::Piece::Player) const;
 
    enum Factors {
@@ -42,6 +63,9 @@ class PositionEvaluator : public IPositionEvaluator
    // Piece values are well-known, so we make them static here.
    std::vector<int> piece_value;
    std::vector<int> factor_weight;
+
+   // The most the weighted positional terms can add up to, in either sign
+   int lazy_evaluation_margin;
 };
 
 } // namespace game_engine
@@ -0,0 +1,100 @@
+#include "Profiler.hpp"
+
+#ifdef MAE_PROFILE
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace diagnostics
+{
+using std::endl;
+
+const char* const Profiler::TRACE_FILE = "mae_trace.json";
+
+Profiler::Profiler ()
+{
+   this->origin = std::chrono::steady_clock::now ();
+}
+
+Profiler::~Profiler ()
+{
+   write_trace ();
+}
+
+/*==============================================================================
+  The profiler lives until the program exits, so that it can write the zones
+  recorded along the whole run
+  ==============================================================================*/
+Profiler&
+Profiler::get_instance ()
+{
+   static Profiler instance;
+   return instance;
+}
+
+/*==============================================================================
+  Return the zones of the calling thread, which only that thread ever adds to
+  (so recording a zone takes no lock)
+  ==============================================================================*/
+Profiler::ThreadTrace&
+Profiler::get_thread_trace ()
+{
+   static thread_local ThreadTrace* trace = nullptr;
+
+   if (trace == nullptr)
+   {
+      Profiler& profiler = get_instance ();
+      std::lock_guard<std::mutex> lock (profiler.threads_mutex);
+
+      profiler.threads.push_back (std::unique_ptr<ThreadTrace> (new ThreadTrace ()));
+      trace = profiler.threads.back ().get ();
+      trace->id = profiler.threads.size () - 1;
+      trace->nesting = 0;
+   }
+
+   return *trace;
+}
+
+// Nanoseconds since the profiler started
+ullong
+Profiler::now ()
+{
+   return std::chrono::duration_cast<std::chrono::nanoseconds> (
+       std::chrono::steady_clock::now () - get_instance ().origin).count ();
+}
+
+/*==============================================================================
+  Write every zone as a complete event ("ph": "X"). Timestamps and durations
+  are in microseconds, as the format requires.
+  ==============================================================================*/
+void
+Profiler::write_trace () const
+{
+   std::ofstream out (TRACE_FILE);
+   if (!out)
+   {
+      std::cerr << "Could not write the profiling trace to " << TRACE_FILE << endl;
+      return;
+   }
+
+   out << std::fixed << std::setprecision (3) << "{\"traceEvents\":[";
+
+   bool is_first = true;
+   for (uint i = 0; i < this->threads.size (); ++i)
+      for (const Event& event : this->threads[i]->events)
+      {
+         out << (is_first ? "" : ",") << endl
+             << "{\"name\":\"" << event.name << "\",\"cat\":\"mae\",\"ph\":\"X\""
+             << ",\"ts\":" << event.start_ns / 1000.0
+             << ",\"dur\":" << event.duration_ns / 1000.0
+             << ",\"pid\":1,\"tid\":" << this->threads[i]->id << "}";
+         is_first = false;
+      }
+
+   out << endl << "],\"displayTimeUnit\":\"ns\"}" << endl;
+}
+
+} // namespace diagnostics
+
+#endif // MAE_PROFILE
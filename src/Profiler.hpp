@@ -0,0 +1,109 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/*==============================================================================
+  Scoped profiling zones: PROFILE_ZONE ("name") records when the enclosing
+  scope was entered and left. At exit, all the zones recorded by every thread
+  are written to TRACE_FILE in the Chrome trace-event format, which can be
+  opened with chrome://tracing or https://ui.perfetto.dev
+
+  Zones are only compiled in when MAE_PROFILE is defined (build with
+  'make rebuild PROFILE=1'); otherwise PROFILE_ZONE expands to nothing. Zones
+  nested deeper than MAX_NESTING are not recorded, so that the recursion of
+  the search does not flood the trace with millions of tiny zones.
+  ==============================================================================*/
+
+#ifdef MAE_PROFILE
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Util.hpp"
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) \
+   diagnostics::ProfileZone PROFILE_CONCAT (profile_zone_, __LINE__) (name)
+
+namespace diagnostics
+{
+class Profiler
+{
+  public:
+   static const char* const TRACE_FILE;
+   static const uint MAX_NESTING = 8;
+
+   struct Event
+   {
+      const char* name;
+      ullong start_ns;
+      ullong duration_ns;
+   };
+
+   // The zones recorded by a single thread
+   struct ThreadTrace
+   {
+      uint id;
+      uint nesting;
+      std::vector<Event> events;
+   };
+
+   ~Profiler ();
+
+   static ThreadTrace& get_thread_trace ();
+   static ullong now ();
+
+  private:
+   Profiler ();
+
+   static Profiler& get_instance ();
+   void write_trace () const;
+
+   std::chrono::steady_clock::time_point origin;
+
+   std::mutex threads_mutex;
+   std::vector<std::unique_ptr<ThreadTrace>> threads;
+};
+
+class ProfileZone
+{
+  public:
+   explicit ProfileZone (const char* name)
+      : trace (Profiler::get_thread_trace ()), name (name), start (0)
+   {
+      this->is_recorded = (++this->trace.nesting <= Profiler::MAX_NESTING);
+      if (this->is_recorded)
+         this->start = Profiler::now ();
+   }
+
+   ~ProfileZone ()
+   {
+      if (this->is_recorded)
+      {
+         Profiler::Event event = { this->name, this->start, Profiler::now () - this->start };
+         this->trace.events.push_back (event);
+      }
+      --this->trace.nesting;
+   }
+
+   ProfileZone (const ProfileZone&) = delete;
+   ProfileZone& operator = (const ProfileZone&) = delete;
+
+  private:
+   Profiler::ThreadTrace& trace;
+   const char* name;
+   ullong start;
+   bool is_recorded;
+};
+
+} // namespace diagnostics
+
+#else
+
+#define PROFILE_ZONE(name) ((void) 0)
+
+#endif // MAE_PROFILE
+
+#endif // PROFILER_H
@@ -2,27 +2,28 @@
 
 namespace game_rules
 {
-Queen::Queen ()
-{
-   this->rook = new Rook ();
-   this->bishop = new Bishop ();
-}
+Queen::Queen () { }
 
-Queen::~Queen ()
-{
-   delete this->rook;
-   delete this->bishop;
-}
+Queen::~Queen () { }
 
 /*=============================================================================
   Get a bitboard containing all valid moves for a queen in LOCATION, assuming
   it is PLAYER's turn (moves that leave the king in check are also included)
   ===========================================================================*/
 bitboard
-Queen::get_moves (uint square, Player player, const IBoard* board) const
+Queen::get_moves (uint square, Player player, const MaeBoard* board) const
+{
+   bitboard attacks = this->bishop.get_moves (square, player, board);
+   attacks |= this->rook.get_moves (square, player, board);
+
+   return attacks;
+}
+
+bitboard
+Queen::get_attacks (uint square, Player player, const MaeBoard* board) const
 {
-   bitboard attacks = this->bishop->get_moves (square, player, board);
-   attacks |= this->rook->get_moves (square, player, board);
+   bitboard attacks = this->bishop.get_attacks (square, player, board);
+   attacks |= this->rook.get_attacks (square, player, board);
 
    return attacks;
 }
@@ -30,8 +31,8 @@ Queen::get_moves (uint square, Player player, const IBoard* board) const
 bitboard
 Queen::get_potential_moves (uint square, Player player) const
 {
-   bitboard moves = this->bishop->get_potential_moves (square, player);
-   moves |= this->rook->get_potential_moves (square, player);
+   bitboard moves = this->bishop.get_potential_moves (square, player);
+   moves |= this->rook.get_potential_moves (square, player);
 
    return moves;
 }
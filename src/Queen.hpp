@@ -11,19 +11,20 @@
 
 namespace game_rules
 {
-class Queen : public Piece
+class Queen final : public Piece
 {
 public:
    Queen ();
    ~Queen ();
 
-   bitboard get_moves (uint square, Player player, const IBoard* board) const;
+   bitboard get_moves (uint square, Player player, const MaeBoard* board) const;
+   bitboard get_attacks (uint square, Player player, const MaeBoard* board) const;
    bitboard get_potential_moves (uint square, Player player) const;
 
 private:
    // Queen's moves are simply the combination of Rook and Bishop's moves
-   Rook* rook;
-   Bishop* bishop;
+   Rook rook;
+   Bishop bishop;
 };
 
 } // namespace game_rules
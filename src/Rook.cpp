@@ -1,12 +1,13 @@
 #include "Rook.hpp"
-#include "IBoard.hpp"
+#include "MaeBoard.hpp"
 
 namespace game_rules
 {
-Rook::Rook ()
-{
-   compute_moves ();
-}
+const bool Rook::moves_computed = Rook::compute_moves ();
+bitboard Rook::moves_from[BOARD_SQUARES_COUNT][Piece::RAY_DIRECTIONS_COUNT];
+bitboard Rook::all_moves_from[BOARD_SQUARES_COUNT];
+
+Rook::Rook () { }
 
 Rook::~Rook () { }
 /*=============================================================================
@@ -17,7 +18,17 @@ Rook::~Rook () { }
   moves
   ============================================================================*/
 bitboard
-Rook::get_moves (uint square, Piece::Player player, const IBoard* board) const
+Rook::get_moves (uint square, Piece::Player player, const MaeBoard* board) const
+{
+   return get_attacks (square, player, board) & ~board->get_pieces (player);
+}
+
+/*=============================================================================
+  Get all squares attacked from SQUARE in the current BOARD, i.e. the squares
+  along each row and column up to and including the first piece found
+  ============================================================================*/
+bitboard
+Rook::get_attacks (uint square, Piece::Player /* player */, const MaeBoard* board) const
 {
    bitboard attacks = 0;
    bitboard blocking_pieces;
@@ -38,7 +49,6 @@ Rook::get_moves (uint square, Piece::Player player, const IBoard* board) const
             get_ray_from (BoardSquare (square), ray) ^
             (blocking_pieces ? get_ray_from (first_blocking_piece, ray) : 0);
    }
-   attacks &= ~board->get_pieces (player);
 
    return attacks;
 }
@@ -60,7 +70,7 @@ Rook::get_potential_moves (uint square, Player /* player */) const
   Compute all moves a bishop can make from every square on the board assuming
   the board is empty.
   ============================================================================*/
-void
+bool
 Rook::compute_moves ()
 {
    int dx[Piece::RAY_DIRECTIONS_COUNT] = {  0, +1,  0, -1 };
@@ -69,9 +79,9 @@ Rook::compute_moves ()
    for (BoardSquare square = BoardSquare::a8; square <= BoardSquare::h1; ++square)
    {
       for (uint ray = 0; ray < Piece::RAY_DIRECTIONS_COUNT; ++ray)
-         this->moves_from[square][ray] = 0;
+         moves_from[square][ray] = 0;
 
-      this->all_moves_from[square] = 0;
+      all_moves_from[square] = 0;
    }
 
    for (uint row = 0; row < BOARD_SIZE; ++row)
@@ -98,11 +108,13 @@ Rook::compute_moves ()
             {
                y += dy[ray];
                x += dx[ray];
-               this->moves_from[square][ray] |= (util::constants::ONE << (y * BOARD_SIZE + x));
+               moves_from[square][ray] |= (util::constants::ONE << (y * BOARD_SIZE + x));
             }
-            this->all_moves_from[square] |= this->moves_from[square][ray];
+            all_moves_from[square] |= moves_from[square][ray];
          }
       }
+
+   return true;
 }
 
 
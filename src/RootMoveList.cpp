@@ -0,0 +1,106 @@
+#include "RootMoveList.hpp"
+#include "IBoard.hpp"
+#include "MoveGenerator.hpp"
+
+#include <algorithm>
+
+namespace game_engine
+{
+using std::vector;
+using game_rules::Move;
+using game_rules::IBoard;
+
+/*==============================================================================
+  Fill the list with the legal moves of BOARD, keeping only those in
+  SEARCH_MOVES unless it is empty (or none of them is legal).
+  ==============================================================================*/
+void
+RootMoveList::generate (IBoard* board, MoveGenerator* move_generator,
+                        const vector<Move>& search_moves)
+{
+   vector<Move> moves;
+
+   this->moves.clear ();
+   move_generator->generate_moves (board, moves);
+
+   for (uint i = 0; i < moves.size (); ++i)
+   {
+      IBoard::Error error = board->make_move (moves[i], /* is_computer_move: */ true);
+      if (error == IBoard::KING_LEFT_IN_CHECK)
+         continue;
+
+      board->undo_move ();
+
+      RootMove root_move = { moves[i], 0, 0, 0 };
+      this->moves.push_back (root_move);
+   }
+
+   if (search_moves.empty ())
+      return;
+
+   vector<RootMove> allowed_moves;
+   for (uint i = 0; i < this->moves.size (); ++i)
+      if (find (search_moves.begin (), search_moves.end (), this->moves[i].move) != search_moves.end ())
+         allowed_moves.push_back (this->moves[i]);
+
+   if (!allowed_moves.empty ())
+      this->moves = allowed_moves;
+}
+
+/*==============================================================================
+  Try MOVE first (e.g. the move stored in the transposition table by a
+  previous search), if it is in the list
+  ==============================================================================*/
+void
+RootMoveList::promote (const Move& move)
+{
+   for (uint i = 1; i < this->moves.size (); ++i)
+      if (this->moves[i].move == move)
+      {
+         std::rotate (this->moves.begin (), this->moves.begin () + i, this->moves.begin () + i + 1);
+         break;
+      }
+}
+
+void
+RootMoveList::start_iteration ()
+{
+   for (uint i = 0; i < this->moves.size (); ++i)
+      this->moves[i].nodes = 0;
+}
+
+/*==============================================================================
+  The move at INDEX was searched, getting SCORE after visiting NODES nodes.
+  Re-searches of the same iteration add up to its node count.
+  ==============================================================================*/
+void
+RootMoveList::record (uint index, int score, ullong nodes)
+{
+   this->moves[index].score = score;
+   this->moves[index].nodes += nodes;
+   this->moves[index].total_nodes += nodes;
+}
+
+/*==============================================================================
+  Order the list for the next iteration: BEST_MOVES (the best lines of the
+  iteration just finished) first and in their order, and then the rest by
+  the size of their subtrees, since a move that took long to refute is likely
+  to be the best alternative.
+  ==============================================================================*/
+void
+RootMoveList::sort (const vector<Move>& best_moves)
+{
+   auto rank = [&best_moves] (const RootMove& root_move) -> uint {
+      return find (best_moves.begin (), best_moves.end (), root_move.move) - best_moves.begin ();
+   };
+
+   std::stable_sort (this->moves.begin (), this->moves.end (),
+                     [&rank] (const RootMove& a, const RootMove& b) {
+                        uint rank_a = rank (a), rank_b = rank (b);
+                        if (rank_a != rank_b)
+                           return rank_a < rank_b;
+                        return a.nodes > b.nodes;
+                     });
+}
+
+} // namespace game_engine
@@ -0,0 +1,50 @@
+#ifndef ROOT_MOVE_LIST_H
+#define ROOT_MOVE_LIST_H
+
+/*==============================================================================
+  Keeps the legal moves of the root position along a whole search, together
+  with what the last iteration learned about each of them (its score and the
+  size of its subtree), so that the next iteration can try them in a better
+  order than the one given by the move generator.
+  ==============================================================================*/
+
+#include <vector>
+
+#include "Util.hpp"
+#include "Move.hpp"
+
+namespace game_rules { class IBoard; }
+
+namespace game_engine
+{
+class MoveGenerator;
+
+class RootMoveList
+{
+  public:
+   struct RootMove
+   {
+      game_rules::Move move;
+      int score;            // Only exact for the best move (a bound for the rest)
+      ullong nodes;         // Visited in its subtree by the last iteration
+      ullong total_nodes;   // Visited in its subtree by the whole search
+   };
+
+   void generate (game_rules::IBoard*, MoveGenerator*,
+                  const std::vector<game_rules::Move>& search_moves);
+   void promote (const game_rules::Move& move);
+
+   void start_iteration ();
+   void record (uint index, int score, ullong nodes);
+   void sort (const std::vector<game_rules::Move>& best_moves);
+
+   uint size () const { return this->moves.size (); }
+   const RootMove& operator [] (uint index) const { return this->moves[index]; }
+
+  private:
+   std::vector<RootMove> moves;
+};
+
+} // namespace game_engine
+
+#endif // ROOT_MOVE_LIST_H
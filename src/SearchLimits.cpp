@@ -0,0 +1,59 @@
+#include "SearchLimits.hpp"
+
+namespace game_engine
+{
+SearchLimits::SearchLimits ()
+{
+   this->depth = 0;
+   this->nodes = 0;
+   this->move_time = 0;
+   this->moves_to_go = 0;
+   this->mate = 0;
+   this->infinite = false;
+
+   for (uint i = 0; i < game_rules::PLAYERS_COUNT; ++i)
+   {
+      this->has_clock[i] = false;
+      this->time_left[i] = 0;
+      this->increment[i] = 0;
+   }
+}
+
+void
+SearchLimits::set_clock (uint player, long long time_left)
+{
+   this->has_clock[player] = true;
+   this->time_left[player] = (time_left > 0 ? time_left : 0);
+}
+
+/*==============================================================================
+  Return MOVE_TIME if given. Otherwise, if PLAYER has a clock, return an even
+  share of its time left for the moves until the next time control (assumed
+  to be 30 in sudden death games) plus most of its increment, always keeping
+  a reserve. With no time left at all, only part of the increment is spent.
+  ==============================================================================*/
+uint
+SearchLimits::get_move_time (uint player) const
+{
+   if (this->move_time != 0 || !this->has_clock[player])
+      return this->move_time;
+
+   uint time_left = this->time_left[player];
+   uint budget;
+
+   if (time_left == 0)
+      budget = this->increment[player] / 2;
+   else
+   {
+      uint moves = (this->moves_to_go > 0 ? this->moves_to_go : 30);
+      uint reserve = time_left / 10;
+
+      budget = time_left / moves + this->increment[player] * 3 / 4;
+      if (budget > time_left - reserve)
+         budget = time_left - reserve;
+   }
+
+   return (budget > 0 ? budget : 1);
+}
+
+} // namespace game_engine
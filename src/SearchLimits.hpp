@@ -0,0 +1,49 @@
+#ifndef SEARCH_LIMITS_H
+#define SEARCH_LIMITS_H
+
+/*==============================================================================
+  When a search must stop. Every limit set (i.e. not zero) applies, and the
+  search stops at the first one reached; the first iteration is always
+  completed, though, so that there is a move to return.
+
+  A search bounded only by DEPTH or NODES is exactly reproducible: given the
+  same position and the same contents of the transposition table (e.g. right
+  after IEngine::set_hash_size), it visits the same nodes and returns the same
+  move on any machine.
+  ==============================================================================*/
+
+#include "Util.hpp"
+#include "GameTraits.hpp"
+
+namespace game_engine
+{
+struct SearchLimits
+{
+   uint depth;                                    // Plies; zero for MAX_SEARCH_DEPTH
+   ullong nodes;
+   uint move_time;                                // Milliseconds for this move
+
+   // The clock of each player (indexed by Piece::Player), in milliseconds,
+   // used to choose the time for this move when MOVE_TIME is not given. A
+   // clock showing no time left is still a clock (see set_clock).
+   bool has_clock[game_rules::PLAYERS_COUNT];
+   uint time_left[game_rules::PLAYERS_COUNT];
+   uint increment[game_rules::PLAYERS_COUNT];
+   uint moves_to_go;                              // Until the next time control
+
+   uint mate;                                     // Stop at a mate in this many moves
+   bool infinite;                                 // Ignore everything but DEPTH until stopped
+
+   SearchLimits ();
+
+   // Start the clock of PLAYER at TIME_LEFT milliseconds, which some GUIs let
+   // go below zero once the time is up
+   void set_clock (uint player, long long time_left);
+
+   // Milliseconds PLAYER may spend on this move, zero meaning no limit
+   uint get_move_time (uint player) const;
+};
+
+} // namespace game_engine
+
+#endif // SEARCH_LIMITS_H
@@ -0,0 +1,277 @@
+#include "SearchStatistics.hpp"
+
+namespace game_engine
+{
+using std::vector;
+using std::string;
+
+using diagnostics::PerfCounters;
+
+SearchStatistics::SearchStatistics ()
+{
+   reset ();
+}
+
+void
+SearchStatistics::reset ()
+{
+   this->nodes = 0;
+   this->quiescence_nodes = 0;
+   this->internal_nodes = 0;
+   this->leaf_nodes = 0;
+   this->moves_made = 0;
+
+   this->transposition_probes = 0;
+   this->transposition_hits = 0;
+   for (uint i = 0; i < BOUND_KINDS_COUNT; ++i)
+      this->transposition_cutoffs[i] = 0;
+
+   this->beta_cutoffs = 0;
+   this->first_move_cutoffs = 0;
+   for (uint i = 0; i < CUTOFF_HISTOGRAM_SIZE; ++i)
+      this->cutoff_move_index[i] = 0;
+
+   this->internal_iterative_deepenings = 0;
+
+   for (uint i = 0; i < MAX_PLY; ++i)
+      this->nodes_per_ply[i] = 0;
+
+   this->iterations.clear ();
+   this->hardware = diagnostics::PerfCounters::Reading ();
+   this->iteration_start_nodes = 0;
+   this->iteration_start_quiescence_nodes = 0;
+}
+
+/*==============================================================================
+  Add the counters of OTHER to these ones. Iterations are merged by depth, so
+  that the effort of all threads searching the same iteration is added up.
+  ==============================================================================*/
+void
+SearchStatistics::merge (const SearchStatistics& other)
+{
+   this->nodes += other.nodes;
+   this->quiescence_nodes += other.quiescence_nodes;
+   this->internal_nodes += other.internal_nodes;
+   this->leaf_nodes += other.leaf_nodes;
+   this->moves_made += other.moves_made;
+
+   this->transposition_probes += other.transposition_probes;
+   this->transposition_hits += other.transposition_hits;
+   for (uint i = 0; i < BOUND_KINDS_COUNT; ++i)
+      this->transposition_cutoffs[i] += other.transposition_cutoffs[i];
+
+   this->beta_cutoffs += other.beta_cutoffs;
+   this->first_move_cutoffs += other.first_move_cutoffs;
+   for (uint i = 0; i < CUTOFF_HISTOGRAM_SIZE; ++i)
+      this->cutoff_move_index[i] += other.cutoff_move_index[i];
+
+   this->internal_iterative_deepenings += other.internal_iterative_deepenings;
+
+   for (uint i = 0; i < MAX_PLY; ++i)
+      this->nodes_per_ply[i] += other.nodes_per_ply[i];
+
+   this->hardware.add (other.hardware);
+
+   for (uint i = 0; i < other.iterations.size (); ++i)
+   {
+      const Iteration& iteration = other.iterations[i];
+
+      uint j = 0;
+      while (j < this->iterations.size () && this->iterations[j].depth != iteration.depth)
+         ++j;
+
+      if (j == this->iterations.size ())
+      {
+         this->iterations.push_back (iteration);
+      }
+      else
+      {
+         this->iterations[j].nodes += iteration.nodes;
+         this->iterations[j].quiescence_nodes += iteration.quiescence_nodes;
+         this->iterations[j].re_searches += iteration.re_searches;
+         if (iteration.elapsed_ms > this->iterations[j].elapsed_ms)
+            this->iterations[j].elapsed_ms = iteration.elapsed_ms;
+      }
+   }
+}
+
+void
+SearchStatistics::count_node (uint ply)
+{
+   this->nodes++;
+   this->nodes_per_ply[ply < MAX_PLY ? ply : MAX_PLY - 1]++;
+}
+
+/*==============================================================================
+  Quiescence nodes are also counted as nodes, so NODES is always the total
+  number of positions visited by the search.
+  ==============================================================================*/
+void
+SearchStatistics::count_quiescence_node (uint ply)
+{
+   count_node (ply);
+   this->quiescence_nodes++;
+}
+
+/*==============================================================================
+  Count a beta cutoff produced by the MOVE_INDEX-th legal move tried at a node
+  (starting at 0). Good move ordering makes most cutoffs happen at index 0.
+  ==============================================================================*/
+void
+SearchStatistics::count_beta_cutoff (uint move_index)
+{
+   this->beta_cutoffs++;
+   if (move_index == 0)
+      this->first_move_cutoffs++;
+
+   if (move_index >= CUTOFF_HISTOGRAM_SIZE)
+      move_index = CUTOFF_HISTOGRAM_SIZE - 1;
+
+   this->cutoff_move_index[move_index]++;
+}
+
+void
+SearchStatistics::count_transposition_probe (bool hit)
+{
+   this->transposition_probes++;
+   if (hit)
+      this->transposition_hits++;
+}
+
+void
+SearchStatistics::count_transposition_cutoff (uint accuracy)
+{
+   if (accuracy < BOUND_KINDS_COUNT)
+      this->transposition_cutoffs[accuracy]++;
+}
+
+void
+SearchStatistics::start_iteration (uint depth)
+{
+   Iteration iteration = { depth, 0, 0, 0, 0.0 };
+   this->iterations.push_back (iteration);
+
+   this->iteration_start = std::chrono::steady_clock::now ();
+   this->iteration_start_nodes = this->nodes;
+   this->iteration_start_quiescence_nodes = this->quiescence_nodes;
+}
+
+void
+SearchStatistics::count_re_search ()
+{
+   if (!this->iterations.empty ())
+      this->iterations.back ().re_searches++;
+}
+
+void
+SearchStatistics::finish_iteration ()
+{
+   if (this->iterations.empty ())
+      return;
+
+   std::chrono::duration<double, std::milli> elapsed =
+         std::chrono::steady_clock::now () - this->iteration_start;
+
+   Iteration& iteration = this->iterations.back ();
+   iteration.nodes = this->nodes - this->iteration_start_nodes;
+   iteration.quiescence_nodes = this->quiescence_nodes - this->iteration_start_quiescence_nodes;
+   iteration.elapsed_ms = elapsed.count ();
+}
+
+double
+SearchStatistics::first_move_cutoff_rate () const
+{
+   if (this->beta_cutoffs == 0)
+      return 0.0;
+
+   return (double) this->first_move_cutoffs / this->beta_cutoffs;
+}
+
+double
+SearchStatistics::transposition_hit_rate () const
+{
+   if (this->transposition_probes == 0)
+      return 0.0;
+
+   return (double) this->transposition_hits / this->transposition_probes;
+}
+
+/*==============================================================================
+  Write all counters to OUT as a single line of JSON, along with the SCORE and
+  PRINCIPAL_VARIATION (in coordinate notation) found by the search.
+  ==============================================================================*/
+void
+SearchStatistics::write_json (
+    std::ostream& out, int score, const vector<string>& principal_variation) const
+{
+   double total_ms = 0.0;
+   for (uint i = 0; i < this->iterations.size (); ++i)
+      total_ms += this->iterations[i].elapsed_ms;
+
+   out << "{\"score\":" << score
+       << ",\"depth\":" << (this->iterations.empty () ? 0 : this->iterations.back ().depth)
+       << ",\"time_ms\":" << total_ms
+       << ",\"nodes\":" << this->nodes
+       << ",\"quiescence_nodes\":" << this->quiescence_nodes
+       << ",\"internal_nodes\":" << this->internal_nodes
+       << ",\"leaf_nodes\":" << this->leaf_nodes
+       << ",\"average_branching_factor\":"
+       << (this->internal_nodes ? (double) this->moves_made / this->internal_nodes : 0.0)
+       << ",\"tt_probes\":" << this->transposition_probes
+       << ",\"tt_hits\":" << this->transposition_hits
+       << ",\"tt_cutoffs\":{\"exact\":" << this->transposition_cutoffs[0]
+       << ",\"upper_bound\":" << this->transposition_cutoffs[1]
+       << ",\"lower_bound\":" << this->transposition_cutoffs[2] << "}"
+       << ",\"beta_cutoffs\":" << this->beta_cutoffs
+       << ",\"first_move_cutoff_rate\":" << first_move_cutoff_rate ()
+       << ",\"iid_searches\":" << this->internal_iterative_deepenings;
+
+   out << ",\"cutoff_move_index\":[";
+   for (uint i = 0; i < CUTOFF_HISTOGRAM_SIZE; ++i)
+      out << (i ? "," : "") << this->cutoff_move_index[i];
+   out << "]";
+
+   // Only report plies that were actually reached
+   uint plies = MAX_PLY;
+   while (plies > 0 && this->nodes_per_ply[plies - 1] == 0)
+      --plies;
+
+   out << ",\"nodes_per_ply\":[";
+   for (uint i = 0; i < plies; ++i)
+      out << (i ? "," : "") << this->nodes_per_ply[i];
+   out << "]";
+
+   out << ",\"iterations\":[";
+   for (uint i = 0; i < this->iterations.size (); ++i)
+   {
+      const Iteration& iteration = this->iterations[i];
+      out << (i ? "," : "")
+          << "{\"depth\":" << iteration.depth
+          << ",\"nodes\":" << iteration.nodes
+          << ",\"quiescence_nodes\":" << iteration.quiescence_nodes
+          << ",\"re_searches\":" << iteration.re_searches
+          << ",\"time_ms\":" << iteration.elapsed_ms << "}";
+   }
+   out << "]";
+
+   if (this->hardware.is_counted[PerfCounters::CYCLES])
+   {
+      const PerfCounters::Reading& hardware = this->hardware;
+
+      out << ",\"hardware\":{\"cycles\":" << hardware.count[PerfCounters::CYCLES]
+          << ",\"instructions\":" << hardware.count[PerfCounters::INSTRUCTIONS]
+          << ",\"instructions_per_node\":"
+          << (this->nodes ? (double) hardware.count[PerfCounters::INSTRUCTIONS] / this->nodes : 0.0)
+          << ",\"ipc\":" << hardware.instructions_per_cycle ()
+          << ",\"branch_miss_rate\":" << hardware.branch_miss_rate ()
+          << ",\"l1d_miss_rate\":" << hardware.l1d_miss_rate ()
+          << ",\"llc_miss_rate\":" << hardware.llc_miss_rate () << "}";
+   }
+
+   out << ",\"pv\":[";
+   for (uint i = 0; i < principal_variation.size (); ++i)
+      out << (i ? "," : "") << "\"" << principal_variation[i] << "\"";
+   out << "]}" << std::endl;
+}
+
+} // namespace game_engine
@@ -0,0 +1,98 @@
+#ifndef SEARCH_STATISTICS_H
+#define SEARCH_STATISTICS_H
+
+/*==============================================================================
+  Collects counters about a single search (nodes, transposition table usage,
+  move ordering quality, per-ply and per-iteration effort) and writes them as a
+  single JSON line, so that tools can consume them.
+
+  Each search thread owns its own instance; instances can be merged to get
+  the totals of a parallel search.
+  ==============================================================================*/
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Util.hpp"
+#include "PerfCounters.hpp"
+
+namespace game_engine
+{
+class SearchStatistics
+{
+  public:
+   SearchStatistics ();
+
+   // Deepest ply for which per-ply counters are kept (deeper plies are
+   // accumulated in the last slot)
+   static const uint MAX_PLY = 64;
+
+   // Beta cutoffs produced by the n-th move tried are counted in slot n; the
+   // last slot also counts cutoffs produced by any later move
+   static const uint CUTOFF_HISTOGRAM_SIZE = 16;
+
+   // Number of bound kinds in TranspositionTable::flag (EXACT, UPPER_BOUND,
+   // LOWER_BOUND)
+   static const uint BOUND_KINDS_COUNT = 3;
+
+   struct Iteration
+   {
+      uint depth;
+      ullong nodes;
+      ullong quiescence_nodes;
+      uint re_searches;
+      double elapsed_ms;
+   };
+
+   void reset ();
+   void merge (const SearchStatistics& other);
+
+   void count_node (uint ply);
+   void count_quiescence_node (uint ply);
+   void count_beta_cutoff (uint move_index);
+   void count_transposition_probe (bool hit);
+   void count_transposition_cutoff (uint accuracy);
+
+   void start_iteration (uint depth);
+   void count_re_search ();
+   void finish_iteration ();
+
+   double first_move_cutoff_rate () const;
+   double transposition_hit_rate () const;
+
+   void write_json (
+       std::ostream& out, int score, const std::vector<std::string>& principal_variation) const;
+
+   ullong nodes;
+   ullong quiescence_nodes;
+   ullong internal_nodes;
+   ullong leaf_nodes;
+   ullong moves_made;
+
+   ullong transposition_probes;
+   ullong transposition_hits;
+   ullong transposition_cutoffs[BOUND_KINDS_COUNT];
+
+   ullong beta_cutoffs;
+   ullong first_move_cutoffs;
+   ullong cutoff_move_index[CUTOFF_HISTOGRAM_SIZE];
+
+   ullong internal_iterative_deepenings;
+
+   ullong nodes_per_ply[MAX_PLY];
+   std::vector<Iteration> iterations;
+
+   // Only counted when asked for (see IEngine::set_hardware_counting)
+   diagnostics::PerfCounters::Reading hardware;
+
+  private:
+   std::chrono::steady_clock::time_point iteration_start;
+   ullong iteration_start_nodes;
+   ullong iteration_start_quiescence_nodes;
+};
+
+} // namespace game_engine
+
+#endif // SEARCH_STATISTICS_H
@@ -0,0 +1,126 @@
+#include "SearchTreeLog.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace game_engine
+{
+using std::string;
+using std::vector;
+using game_rules::Move;
+using game_rules::BoardSquare;
+
+const char SearchTreeLog::MAGIC[8] = { 'M', 'A', 'E', 'T', 'R', 'E', 'E', '1' };
+const uint SearchTreeLog::MAX_LOGGED_PLY;
+
+/*==============================================================================
+  Start a new log in FILE, keeping the nodes at most MAX_PLY plies away from
+  the root that are entered before the search visits MAX_NODES nodes (zero
+  means no limit)
+  ==============================================================================*/
+SearchTreeLog::SearchTreeLog (const string& file, uint max_ply, ullong max_nodes)
+   : out (file.c_str (), std::ios::binary | std::ios::trunc)
+{
+   this->max_ply = std::min (max_ply, MAX_LOGGED_PLY);
+   this->max_nodes = max_nodes;
+
+   for (uint i = 0; i <= MAX_LOGGED_PLY; ++i)
+      this->open_nodes[i].is_logged = false;
+
+   if (this->out)
+      this->out.write (MAGIC, sizeof (MAGIC));
+}
+
+/*==============================================================================
+  The search entered a node at PLY, with the window [ALPHA, BETA], after
+  visiting NODES nodes
+  ==============================================================================*/
+void
+SearchTreeLog::enter (uint ply, Kind kind, int alpha, int beta, ullong nodes)
+{
+   if (ply > this->max_ply)
+      return;
+
+   OpenNode& node = this->open_nodes[ply];
+
+   node.is_logged = (this->max_nodes == 0 || nodes < this->max_nodes);
+   node.record.nodes = nodes;
+   node.record.alpha = alpha;
+   node.record.beta = beta;
+   node.record.value = 0;
+   node.record.move = 0;
+   node.record.ply = ply;
+   node.record.kind = kind;
+   node.record.transposition = TT_MISS;
+   node.record.cutoff_index = NO_CUTOFF;
+}
+
+void
+SearchTreeLog::set_transposition (uint ply, Transposition transposition)
+{
+   if (ply <= this->max_ply)
+      this->open_nodes[ply].record.transposition = transposition;
+}
+
+void
+SearchTreeLog::set_cutoff (uint ply, uint move_index)
+{
+   if (ply <= this->max_ply)
+      this->open_nodes[ply].record.cutoff_index = std::min (move_index, (uint) NO_CUTOFF - 1);
+}
+
+/*==============================================================================
+  The node at PLY, reached through MOVE, was left with VALUE once the search
+  had visited NODES nodes
+  ==============================================================================*/
+void
+SearchTreeLog::leave (uint ply, const Move& move, int value, ullong nodes)
+{
+   if (ply > this->max_ply || !this->open_nodes[ply].is_logged)
+      return;
+
+   OpenNode& node = this->open_nodes[ply];
+
+   node.record.nodes = nodes - node.record.nodes;
+   node.record.value = value;
+   node.record.move = encode (move);
+   node.is_logged = false;
+
+   this->out.write (reinterpret_cast<const char*> (&node.record), sizeof (NodeRecord));
+}
+
+/*==============================================================================
+  Return FALSE if FILE is not a search tree log; otherwise, return its nodes
+  in RECORDS
+  ==============================================================================*/
+bool
+SearchTreeLog::read (const string& file, vector<NodeRecord>& records)
+{
+   std::ifstream in (file.c_str (), std::ios::binary);
+   char magic[sizeof (MAGIC)];
+
+   if (!in.read (magic, sizeof (magic)) || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0)
+      return false;
+
+   records.clear ();
+
+   NodeRecord record;
+   while (in.read (reinterpret_cast<char*> (&record), sizeof (record)))
+      records.push_back (record);
+
+   return true;
+}
+
+ushort
+SearchTreeLog::encode (const Move& move)
+{
+   return (ushort) (move.from () | (move.to () << 6));
+}
+
+Move
+SearchTreeLog::decode (ushort move)
+{
+   return Move (BoardSquare (move & 0x3F), BoardSquare ((move >> 6) & 0x3F));
+}
+
+} // namespace game_engine
@@ -0,0 +1,89 @@
+#ifndef SEARCH_TREE_LOG_H
+#define SEARCH_TREE_LOG_H
+
+/*==============================================================================
+  Writes the nodes visited by a search to a binary file, to be studied
+  offline (see tools/src/mae_tree.cpp) when the search spends far more nodes
+  on a position than expected.
+
+  Each node is written when the search leaves it, as a fixed-size record, so
+  the file holds the tree in post-order: the descendants of a node are the
+  records right before it with a greater ply. Every root search (i.e. every
+  iteration and re-search) ends with a record of ply 0.
+
+  Only the nodes at most MAX_PLY plies away from the root that the search
+  enters before visiting MAX_NODES nodes are logged. The ancestors of a logged
+  node are always logged too, so the file holds a complete (if pruned) tree,
+  and the subtree size of each record counts every node below it, logged or
+  not.
+  ==============================================================================*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "Util.hpp"
+#include "Move.hpp"
+
+namespace game_engine
+{
+class SearchTreeLog
+{
+  public:
+   enum Kind : unsigned char { ROOT, ALPHA_BETA, QUIESCENCE };
+
+   // What the node got from the transposition table
+   enum Transposition : unsigned char { TT_MISS, TT_HIT, TT_CUTOFF };
+
+   static const unsigned char NO_CUTOFF = 0xFF;
+   static const uint MAX_LOGGED_PLY = 128;
+
+   struct NodeRecord
+   {
+      ullong nodes;                   // Visited in its subtree, itself included
+      int alpha, beta;                // Window the node was searched with
+      int value;                      // Returned, from the side to move
+      ushort move;                    // That led to the node: from | to << 6
+      unsigned char ply;
+      Kind kind;
+      Transposition transposition;
+      unsigned char cutoff_index;     // Of the move that failed high, if any
+   };
+
+   SearchTreeLog (const std::string& file, uint max_ply, ullong max_nodes);
+
+   bool is_open () const { return this->out.is_open (); }
+
+   void enter (uint ply, Kind kind, int alpha, int beta, ullong nodes);
+   void set_transposition (uint ply, Transposition transposition);
+   void set_cutoff (uint ply, uint move_index);
+   void leave (uint ply, const game_rules::Move& move, int value, ullong nodes);
+
+   static bool read (const std::string& file, std::vector<NodeRecord>& records);
+
+   static ushort encode (const game_rules::Move& move);
+   static game_rules::Move decode (ushort move);
+
+  private:
+   static const char MAGIC[8];
+
+   // The node being searched at every ply
+   struct OpenNode
+   {
+      bool is_logged;
+      NodeRecord record;
+   };
+
+   std::ofstream out;
+   uint max_ply;
+   ullong max_nodes;
+   OpenNode open_nodes[MAX_LOGGED_PLY + 1];
+};
+
+static_assert (std::is_trivially_copyable<SearchTreeLog::NodeRecord>::value,
+               "Node records are written as plain blocks of memory");
+
+} // namespace game_engine
+
+#endif // SEARCH_TREE_LOG_H
@@ -3,6 +3,7 @@
 #include <cstdlib>
 
 #include "Timer.hpp"
+#include "Logger.hpp"
 
 namespace diagnostics
 {
@@ -67,7 +68,7 @@ Timer::sleep () const
       sleep_command << "sleep " << this->time_out;
       if (system (sleep_command.str().c_str ()))
       {
-         std::cerr << "sleep command failed" << std::endl;
+         LOG_WARNING ("sleep command failed");
       }
    }
 }
@@ -1,15 +1,13 @@
 #include "TranspositionTable.hpp"
 #include "MaeBoard.hpp"
 
-#include <iostream>
+#include <algorithm>
 
 namespace game_engine
 {
 using game_rules::Move;
-using std::unordered_map;
 
 std::map<ushort, uint> TranspositionTable::possible_size;
-size_t TranspositionTable::size;
 
 TranspositionTable::TranspositionTable (uint size)
 {
@@ -20,52 +18,58 @@ TranspositionTable::TranspositionTable (uint size)
    else
       this->hash_size = TranspositionTable::possible_size[64];
 
-   TranspositionTable::size = this->hash_size;
+   this->slots.resize (this->hash_size);
+   reset ();
 }
 
+/*==============================================================================
+  The largest power of two of slots that fits in each of the allowed sizes
+  ==============================================================================*/
 void
 TranspositionTable::set_possible_size ()
 {
-   TranspositionTable::possible_size[16] = 1085137;
-   TranspositionTable::possible_size[32] = 2159363;
-   TranspositionTable::possible_size[64] = 4142027;
-   TranspositionTable::possible_size[128] = 8888437;
-   TranspositionTable::possible_size[256] = 17311163;
+   for (ushort megabytes = 16; megabytes <= MAX_MEMORY; megabytes *= 2)
+   {
+      size_t fitting_slots = (size_t) megabytes * 1024 * 1024 / sizeof (Slot);
+      uint slots = 1;
+
+      while (slots * 2 <= fitting_slots)
+         slots *= 2;
+
+      TranspositionTable::possible_size[megabytes] = slots;
+   }
 }
 
 bool
-TranspositionTable::exists (const BoardKey& board)
+TranspositionTable::exists (const BoardKey& key)
 {
-   return this->entries.find (board) != this->entries.end ();
+   const Slot& slot = get_slot (key);
+
+   return (slot.entry.accuracy != UNKNOWN && slot.verification == get_verification (key));
 }
 
+/*==============================================================================
+  Store the result of searching the board with KEY. A deeper result of the
+  same board is kept, but the board in the slot is replaced by any other.
+  ==============================================================================*/
 bool
 TranspositionTable::add_entry (
     const BoardKey& key, int score, flag accuracy, const Move& best_move, uint depth)
 {
-   auto iter = this->entries.find (key);
+   Slot& slot = get_slot (key);
+   uint verification = get_verification (key);
 
-   // This board is already in the table, so just try to update it
-   if (iter != this->entries.end ())
-   {
-      if (depth >= (*iter).second.depth)
-      {
-         (*iter).second.score = score;
-         (*iter).second.accuracy = accuracy;
-         (*iter).second.best_move = best_move;
-         (*iter).second.depth = depth;
-         return true;
-      }
-      return false;
-   }
+   if (slot.entry.accuracy == UNKNOWN)
+      this->used_slots++;
 
-   TranspositionTable::BoardEntry entry;
-   entry.score = score;
-   entry.accuracy = accuracy;
-   entry.best_move = best_move;
-   entry.depth = depth;
+   else if (slot.verification == verification && depth < slot.entry.depth)
+      return false;
 
-   this->entries.insert (std::pair<BoardKey, BoardEntry>(key, entry));
+   slot.verification = verification;
+   slot.entry.score = score;
+   slot.entry.accuracy = accuracy;
+   slot.entry.best_move = best_move;
+   slot.entry.depth = depth;
 
    return true;
 }
@@ -73,20 +77,17 @@ TranspositionTable::add_entry (
 bool
 TranspositionTable::get_entry (const BoardKey& key, TranspositionTable::BoardEntry& entry)
 {
-   if (exists (key))
-   {
-      auto iter = this->entries.find (key);
-      entry = (*iter).second;
-      return true;
-   }
+   if (!exists (key))
+      return false;
 
-   return false;
+   entry = get_slot (key).entry;
+   return true;
 }
 
 uint
 TranspositionTable::get_size () const
 {
-   return this->entries.size ();
+   return this->used_slots;
 }
 
 uint
@@ -98,7 +99,15 @@ TranspositionTable::get_capacity () const
 void
 TranspositionTable::reset ()
 {
-   this->entries.clear ();
+   Slot empty_slot;
+
+   empty_slot.verification = 0;
+   empty_slot.entry.score = 0;
+   empty_slot.entry.accuracy = UNKNOWN;
+   empty_slot.entry.depth = 0;
+
+   std::fill (this->slots.begin (), this->slots.end (), empty_slot);
+   this->used_slots = 0;
 }
 
 } // namespace game_engine
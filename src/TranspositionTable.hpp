@@ -3,10 +3,12 @@
 
 /*==============================================================================
   Implements a transposition table, used to improve performance of search
-  algorithms such as iterative deepening search
+  algorithms such as iterative deepening search. Boards are stored in a fixed
+  number of slots picked by the low bits of their keys, along with the high
+  bits of the key to tell apart the boards that share a slot.
   ==============================================================================*/
 
-#include <unordered_map>
+#include <vector>
 #include <map>
 
 #include "Util.hpp"
@@ -45,31 +47,23 @@ class TranspositionTable
 
    static void set_possible_size ();
 
+   // Number of slots (always a power of two) for each size in megabytes
    static std::map<ushort, uint> possible_size;
    static const ushort MAX_MEMORY = 256;
-   static size_t size;
 
   private:
-   class board_hasher
+   struct Slot
    {
-     public:
-      size_t operator ()(const BoardKey& key) const
-      {
-         return (size_t) key.hash_key % size;
-      }
+      uint verification;  // High half of the key of the board in the slot
+      BoardEntry entry;   // Empty while its accuracy is UNKNOWN
    };
 
-   class board_comparer
-   {
-     public:
-      bool operator ()(const BoardKey& key, const BoardKey& other_key) const
-      {
-         return key.hash_lock == other_key.hash_lock;
-      }
-   };
+   Slot& get_slot (const BoardKey& key) { return this->slots[key & (this->hash_size - 1)]; }
+   static uint get_verification (const BoardKey& key) { return (uint) (key >> 32); }
 
    uint hash_size;
-   std::unordered_map<BoardKey, BoardEntry, board_hasher, board_comparer> entries;
+   uint used_slots;
+   std::vector<Slot> slots;
 };
 
 } // namespace game_engine
@@ -0,0 +1,338 @@
+#include "UciCommandExecuter.hpp"
+#include "IBoard.hpp"
+#include "FenReader.hpp"
+#include "Move.hpp"
+#include "GameTraits.hpp"
+#include "Logger.hpp"
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+namespace game_ui
+{
+using std::string;
+using std::vector;
+using std::cout;
+
+using game_rules::IBoard;
+using game_rules::Move;
+using game_rules::Piece;
+
+using game_engine::IEngine;
+using game_engine::SearchReport;
+using game_engine::SearchLimits;
+
+using game_persistence::FenReader;
+
+// Bound to references (e.g. by std::min), so they need a definition
+const uint UciCommandExecuter::MAX_MULTI_PV;
+
+UciCommandExecuter::UciCommandExecuter (IBoard* board, IEngine* game_engine)
+{
+   this->board = board;
+   this->game_engine = game_engine;
+   this->is_infinite = false;
+   this->stop_received = false;
+
+   this->game_engine->set_search_observer (this);
+}
+
+UciCommandExecuter::~UciCommandExecuter ()
+{
+   stop ();
+   this->game_engine->set_search_observer (nullptr);
+}
+
+/*==============================================================================
+    Execute a line sent by the GUI. Return FALSE when the GUI asks to quit.
+  ==============================================================================*/
+bool
+UciCommandExecuter::execute (const string& command)
+{
+   std::istringstream arguments (command);
+   string name;
+
+   arguments >> name;
+
+   if (name == "uci")
+      identify ();
+
+   else if (name == "isready")
+      cout << "readyok" << std::endl;
+
+   else if (name == "ucinewgame")
+   {
+      stop ();
+      this->board->load_fen (FenReader::INITIAL_POSITION);
+   }
+   else if (name == "setoption")
+      set_option (arguments);
+
+   else if (name == "position")
+      set_position (arguments);
+
+   else if (name == "go")
+      go (arguments);
+
+   else if (name == "stop")
+      stop ();
+
+   else if (name == "quit")
+      return false;
+
+   return true;
+}
+
+void
+UciCommandExecuter::identify ()
+{
+   cout << "id name MaE" << std::endl
+        << "id author Pawn developers" << std::endl
+        << "option name Hash type spin default " << DEFAULT_HASH_SIZE
+        << " min " << MIN_HASH_SIZE << " max " << MAX_HASH_SIZE << std::endl
+        // The search is single-threaded
+        << "option name Threads type spin default 1 min 1 max 1" << std::endl
+        << "option name MultiPV type spin default 1 min 1 max " << MAX_MULTI_PV << std::endl
+        << "uciok" << std::endl;
+}
+
+/*==============================================================================
+    setoption name <id> [value <x>]
+  ==============================================================================*/
+void
+UciCommandExecuter::set_option (std::istringstream& arguments)
+{
+   string token, name, value;
+
+   arguments >> token;
+   if (token != "name")
+      return;
+
+   while (arguments >> token && token != "value")
+      name += (name.empty () ? "" : " ") + token;
+
+   arguments >> value;
+
+   uint number;
+   if (!(std::istringstream (value) >> number))
+      return;
+
+   if (name == "Hash")
+   {
+      stop ();
+      this->game_engine->set_hash_size (number);
+   }
+   else if (name == "MultiPV")
+   {
+      stop ();
+      this->game_engine->set_multi_pv (std::min (number, MAX_MULTI_PV));
+   }
+}
+
+/*==============================================================================
+    position [startpos | fen <fenstring>] [moves <move1> ... <movei>]
+  ==============================================================================*/
+void
+UciCommandExecuter::set_position (std::istringstream& arguments)
+{
+   string token, fen;
+
+   stop ();
+
+   arguments >> token;
+   if (token == "startpos")
+   {
+      fen = FenReader::INITIAL_POSITION;
+      arguments >> token;
+   }
+   else if (token == "fen")
+   {
+      while (arguments >> token && token != "moves")
+         fen += token + " ";
+   }
+   else
+      return;
+
+   // The board is back at the initial position then, not at one the GUI sent
+   if (!this->board->load_fen (fen))
+   {
+      LOG_WARNING ("Invalid position: %s", fen.c_str ());
+      return;
+   }
+
+   if (token != "moves")
+      return;
+
+   while (arguments >> token)
+   {
+      // Pawns are always promoted to queens by the board
+      if (token.length () > 4 && token[4] != 'q')
+      {
+         LOG_WARNING ("Unsupported promotion: %s", token.c_str ());
+         return;
+      }
+
+      Move move (token);
+      IBoard::Error error = this->board->make_move (move, false);
+
+      if (error != IBoard::NO_ERROR && error != IBoard::DRAW_BY_REPETITION)
+      {
+         LOG_WARNING ("Illegal move: %s", token.c_str ());
+         return;
+      }
+   }
+}
+
+/*==============================================================================
+    go [searchmoves <move1> ... <movei>] [depth <x>] [nodes <x>] [movetime <x>]
+       [wtime <x>] [btime <x>] [winc <x>] [binc <x>] [movestogo <x>] [mate <x>]
+       [infinite]
+  ==============================================================================*/
+void
+UciCommandExecuter::go (std::istringstream& arguments)
+{
+   SearchLimits limits;
+   bool reading_moves = false;
+   vector<Move> search_moves;
+   string token;
+
+   stop ();
+
+   while (arguments >> token)
+   {
+      if (token == "searchmoves")
+      {
+         reading_moves = true;
+         continue;
+      }
+      // The list of moves goes on until the next keyword
+      if (reading_moves && token.length () >= 4 &&
+          Move::is_valid_notation (token.substr (0, 2)) &&
+          Move::is_valid_notation (token.substr (2, 2)))
+      {
+         search_moves.push_back (Move (token));
+         continue;
+      }
+      reading_moves = false;
+
+      if (token == "depth")
+         arguments >> limits.depth;
+      else if (token == "nodes")
+         arguments >> limits.nodes;
+      else if (token == "movetime")
+         arguments >> limits.move_time;
+      else if (token == "movestogo")
+         arguments >> limits.moves_to_go;
+      else if (token == "wtime" || token == "btime")
+      {
+         long long time_left = 0;
+         arguments >> time_left;
+         limits.set_clock (token == "wtime" ? Piece::WHITE : Piece::BLACK, time_left);
+      }
+      else if (token == "winc" || token == "binc")
+      {
+         long long increment = 0;
+         arguments >> increment;
+         limits.increment[token == "winc" ? Piece::WHITE : Piece::BLACK] =
+               (increment > 0 ? increment : 0);
+      }
+      else if (token == "mate")
+         arguments >> limits.mate;
+      else if (token == "infinite")
+         limits.infinite = true;
+   }
+
+   this->game_engine->set_search_moves (search_moves);
+
+   this->is_infinite = limits.infinite;
+   this->stop_received = false;
+
+   // Must be called before the thread starts, so that an early stop is not lost
+   if (limits.infinite)
+      this->game_engine->start_infinite_search ();
+   else
+      this->game_engine->prepare_search ();
+
+   this->search_thread = std::thread (&UciCommandExecuter::run_search, this, limits);
+}
+
+/*==============================================================================
+    Stop the running search, if any, and wait for it to report its best move
+  ==============================================================================*/
+void
+UciCommandExecuter::stop ()
+{
+   if (!this->search_thread.joinable ())
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock (this->search_mutex);
+
+      this->stop_received = true;
+      this->game_engine->stop ();
+      this->search_state_changed.notify_all ();
+   }
+
+   this->search_thread.join ();
+}
+
+/*==============================================================================
+    Body of the search thread: search within LIMITS, and report the best move
+    along with the expected reply.
+  ==============================================================================*/
+void
+UciCommandExecuter::run_search (SearchLimits limits)
+{
+   Move best_move;
+   vector<Move> principal_variation;
+
+   this->game_engine->get_best_move (limits, this->board, best_move);
+   this->game_engine->get_principal_variation (principal_variation);
+
+   {
+      std::unique_lock<std::mutex> lock (this->search_mutex);
+
+      while (this->is_infinite && !this->stop_received)
+         this->search_state_changed.wait (lock);
+   }
+
+   // There is no move to report in a finished game
+   if (best_move.is_null ())
+   {
+      cout << "bestmove 0000" << std::endl;
+      return;
+   }
+
+   cout << "bestmove " << best_move.get_notation ();
+   if (principal_variation.size () > 1)
+      cout << " ponder " << principal_variation[1].get_notation ();
+   cout << std::endl;
+}
+
+/*==============================================================================
+    Send the thinking output of the engine as an 'info' line
+  ==============================================================================*/
+void
+UciCommandExecuter::on_search_report (const SearchReport& report)
+{
+   ullong time = (ullong) report.elapsed_ms;
+   ullong nodes_per_second = report.nodes * 1000 / (time > 0 ? time : 1);
+
+   std::ostringstream line;
+   line << "info depth " << report.depth
+        << " multipv " << report.line
+        << " score " << (report.is_mate ? "mate " : "cp ") << report.score
+        << " time " << time
+        << " nodes " << report.nodes
+        << " nps " << nodes_per_second
+        << " hashfull " << report.hashfull
+        << " pv";
+
+   for (uint i = 0; i < report.principal_variation.size (); ++i)
+      line << " " << report.principal_variation[i].get_notation ();
+
+   cout << line.str () << std::endl;
+}
+
+} // namespace game_ui
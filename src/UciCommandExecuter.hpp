@@ -0,0 +1,64 @@
+#ifndef UCI_COMMAND_EXECUTER_H
+#define UCI_COMMAND_EXECUTER_H
+
+/*==============================================================================
+  Front end for GUIs and tools speaking the UCI protocol. Unlike Xboard, UCI
+  sends the whole position before every search, and expects the engine to
+  report its best move instead of making it, so the board is only changed
+  by the 'position' command.
+  ==============================================================================*/
+
+#include <string>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Util.hpp"
+#include "IEngine.hpp"
+#include "ISearchObserver.hpp"
+
+namespace game_rules { class IBoard; }
+
+namespace game_ui
+{
+class UciCommandExecuter : public game_engine::ISearchObserver
+{
+  public:
+   UciCommandExecuter (game_rules::IBoard*, game_engine::IEngine*);
+   ~UciCommandExecuter ();
+
+   bool execute (const std::string& command);
+   void on_search_report (const game_engine::SearchReport& report);
+
+   // In megabytes (see TranspositionTable::possible_size)
+   static const uint DEFAULT_HASH_SIZE = 64;
+   static const uint MIN_HASH_SIZE = 16;
+   static const uint MAX_HASH_SIZE = 256;
+
+   static const uint MAX_MULTI_PV = 64;
+
+  private:
+   game_rules::IBoard* board;
+   game_engine::IEngine* game_engine;
+
+   // Searches run on SEARCH_THREAD, so that 'stop' and 'isready' are answered
+   // while the engine thinks. An infinite search does not report its best
+   // move until STOP_RECEIVED
+   std::thread search_thread;
+   std::mutex search_mutex;
+   std::condition_variable search_state_changed;
+   bool is_infinite;
+   bool stop_received;
+
+   void identify ();
+   void set_option (std::istringstream& arguments);
+   void set_position (std::istringstream& arguments);
+   void go (std::istringstream& arguments);
+   void stop ();
+   void run_search (game_engine::SearchLimits limits);
+};
+
+} // namespace game_ui
+
+#endif // UCI_COMMAND_EXECUTER_H
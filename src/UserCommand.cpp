@@ -30,6 +30,10 @@ UserCommand::UserCommand (string& notation)
    if (UserCommand::notation_to_key.find (notation) != UserCommand::notation_to_key.end ())
       this->key = UserCommand::notation_to_key[notation];
 
+   else if (notation.find ("setboard ") == 0)
+   {
+      this->key = SET_BOARD;
+   }
    else if (notation.find ("usermove") != string::npos &&
             notation.find ("accepted") == string::npos)
    {
@@ -57,6 +61,20 @@ UserCommand::load_commands ()
    notation_to_key["remove"] = REMOVE;
    notation_to_key["train"] = TRAIN;
    notation_to_key["auto"] = COMPUTER_PLAY;
+   notation_to_key["statistics"] = STATISTICS;
+   notation_to_key["hard"] = PONDER_ON;
+   notation_to_key["easy"] = PONDER_OFF;
+   notation_to_key["?"] = MOVE_NOW;
+   notation_to_key["stop"] = MOVE_NOW;
+   notation_to_key["force"] = FORCE;
+   notation_to_key["go"] = GO;
+   notation_to_key["analyze"] = ANALYZE;
+   notation_to_key["exit"] = EXIT_ANALYSIS;
+   notation_to_key["."] = ANALYSIS_UPDATE;
+   notation_to_key["post"] = POST;
+   notation_to_key["nopost"] = NO_POST;
+   notation_to_key["setboard"] = SET_BOARD;
+   notation_to_key["uci"] = UCI_MODE;
 
    key_to_notation[XBOARD_MODE] = "xboard";
    key_to_notation[FEATURES] = "protover 2";
@@ -69,6 +87,19 @@ UserCommand::load_commands ()
    key_to_notation[REMOVE] = "remove";
    key_to_notation[TRAIN] = "train";
    key_to_notation[COMPUTER_PLAY] = "auto";
+   key_to_notation[STATISTICS] = "statistics";
+   key_to_notation[PONDER_ON] = "hard";
+   key_to_notation[PONDER_OFF] = "easy";
+   key_to_notation[MOVE_NOW] = "?";
+   key_to_notation[FORCE] = "force";
+   key_to_notation[GO] = "go";
+   key_to_notation[ANALYZE] = "analyze";
+   key_to_notation[EXIT_ANALYSIS] = "exit";
+   key_to_notation[ANALYSIS_UPDATE] = ".";
+   key_to_notation[POST] = "post";
+   key_to_notation[NO_POST] = "nopost";
+   key_to_notation[SET_BOARD] = "setboard";
+   key_to_notation[UCI_MODE] = "uci";
 
    return true;
 }
@@ -28,6 +28,19 @@ class UserCommand
       MOVE,
       TRAIN,
       COMPUTER_PLAY,
+      STATISTICS,
+      PONDER_ON,
+      PONDER_OFF,
+      MOVE_NOW,
+      FORCE,
+      GO,
+      ANALYZE,
+      EXIT_ANALYSIS,
+      ANALYSIS_UPDATE,
+      POST,
+      NO_POST,
+      SET_BOARD,
+      UCI_MODE,
       UNKNOWN
    };
 
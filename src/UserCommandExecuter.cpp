@@ -12,6 +12,7 @@
 #include <vector>
 #include <cstdlib>
 #include <memory>
+#include <sstream>
 
 namespace game_ui
 {
@@ -36,15 +37,62 @@ UserCommandExecuter::UserCommandExecuter (
    this->board = board;
    this->game_engine = game_engine;
    this->move_generator = new game_engine::MoveGenerator ();
+   this->statistics_enabled = false;
+   this->force_mode = false;
+   this->analysis_mode = false;
+   this->post_enabled = false;
+   this->search_state = IDLE;
+   this->search_cancelled = false;
+   this->ponder_enabled = false;
+
+   this->game_engine->set_search_observer (this);
+}
+
+UserCommandExecuter::~UserCommandExecuter ()
+{
+   cancel_search ();
+   this->game_engine->set_search_observer (nullptr);
+}
+
+/*==============================================================================
+    Return TRUE if the command with the given KEY may be executed while a
+    search runs on the board, i.e. it neither touches the board nor the engine
+    in a way that requires the search to be cancelled first.
+  ==============================================================================*/
+bool
+UserCommandExecuter::can_run_while_searching (UserCommand::CommandKey key)
+{
+   switch (key)
+   {
+   case UserCommand::USER_MOVE:   // Decides by itself (see make_user_move)
+   case UserCommand::MOVE_NOW:
+   case UserCommand::PONDER_ON:
+   case UserCommand::PONDER_OFF:
+   case UserCommand::ANALYSIS_UPDATE:
+   case UserCommand::POST:
+   case UserCommand::NO_POST:
+   case UserCommand::UNKNOWN:
+      return true;
+
+   default:
+      return false;
+   }
 }
 
 bool
 UserCommandExecuter::execute (const UserCommand& command)
 {
-   switch (command.get_key ())
+   UserCommand::CommandKey key = command.get_key ();
+
+   // The board cannot be touched while a search runs on it
+   if (!can_run_while_searching (key))
+      cancel_search ();
+
+   switch (key)
    {
    case UserCommand::NEW_GAME:
       this->board->reset ();
+      this->force_mode = false;
       break;
 
    case UserCommand::UNDO_MOVE:
@@ -66,7 +114,7 @@ UserCommandExecuter::execute (const UserCommand& command)
 
    case UserCommand::FEATURES:
       cout << "feature setboard=1 usermove=1 time=0 draw=0 sigint=0 "
-           << "sigterm=0 variants=\"normal\" analyze=0 colors=0 "
+           << "sigterm=0 variants=\"normal\" analyze=1 colors=0 "
            << "myname=\"MaE\" done=1" << std::endl;
       break;
 
@@ -78,6 +126,56 @@ UserCommandExecuter::execute (const UserCommand& command)
       think ();
       break;
 
+   case UserCommand::MOVE_NOW:
+      move_now ();
+      break;
+
+   case UserCommand::FORCE:
+      this->force_mode = true;
+      break;
+
+   case UserCommand::GO:
+      this->force_mode = false;
+      think ();
+      break;
+
+   case UserCommand::ANALYZE:
+      this->analysis_mode = true;
+      break;
+
+   case UserCommand::EXIT_ANALYSIS:
+      this->analysis_mode = false;
+      break;
+
+   case UserCommand::ANALYSIS_UPDATE:
+      break;
+
+   case UserCommand::SET_BOARD:
+      // Strip off the string 'setboard ' sent by Xboard before the position
+      if (!this->board->load_fen (command.get_notation ().substr (9)))
+         cout << "tellusererror Illegal position" << std::endl;
+      break;
+
+   case UserCommand::POST:
+      this->post_enabled = true;
+      break;
+
+   case UserCommand::NO_POST:
+      this->post_enabled = false;
+      break;
+
+   case UserCommand::STATISTICS:
+      toggle_statistics ();
+      break;
+
+   case UserCommand::PONDER_ON:
+      set_pondering (true);
+      break;
+
+   case UserCommand::PONDER_OFF:
+      set_pondering (false);
+      break;
+
    case UserCommand::TRAIN:
       train_by_genetic_algorithm (
           /* population_size: */ 6,
@@ -88,6 +186,12 @@ UserCommandExecuter::execute (const UserCommand& command)
    default:
       break;
    }
+
+   // Analysis goes on after any change of the position, reusing the tables
+   // filled so far
+   if (this->analysis_mode && !this->search_thread.joinable ())
+      analyze ();
+
    return true;
 }
 
@@ -131,12 +235,30 @@ UserCommandExecuter::make_user_move (const string& command)
       // Strip off the string 'usermove ' sent by Xboard before the actual move
       string notation = command.substr (i + 1);
       Move move (notation);
+
+      {
+         std::lock_guard<std::mutex> lock (this->search_mutex);
+
+         if (this->search_state == PONDERING && move == this->ponder_move)
+         {
+            // Ponder hit: the move is already on the board, and the search
+            // carries on as a normal one that plays its move when done
+            this->search_state = THINKING;
+            this->game_engine->ponder_hit ();
+            this->search_state_changed.notify_all ();
+            return;
+         }
+      }
+
+      cancel_search ();
+
       IBoard::Error error = this->board->make_move (move, false);
 
       switch (error)
       {
       case IBoard::NO_ERROR:
-         think ();
+         if (!this->force_mode && !this->analysis_mode)
+            think ();
          break;
 
       case IBoard::DRAW_BY_REPETITION:
@@ -158,17 +280,140 @@ UserCommandExecuter::make_user_move (const string& command)
 }
 
 /*==============================================================================
-    Query the engine for the most promising move and communicate the response
-    to the GUI. It also communicates check mates and draws.
+    Start searching for the most promising move in the background. The move
+    is communicated to the GUI as soon as the search is over (see run_search).
   ==============================================================================*/
 void
 UserCommandExecuter::think ()
 {
-   Move best_move;
-   uint depth = 3;
+   cancel_search ();
+
+   this->search_state = THINKING;
+   this->search_cancelled = false;
+
+   // Must be called before the thread starts, so that an early stop is not lost
+   this->game_engine->prepare_search ();
+
+   this->search_thread = std::thread (&UserCommandExecuter::run_search, this);
+}
+
+/*==============================================================================
+    Body of the search thread: search, play the best move and, if enabled,
+    ponder on the expected reply. A ponder hit turns the ponder search into
+    the next move's search, so the loop goes on until there is nothing else to
+    search or the search is cancelled.
+  ==============================================================================*/
+void
+UserCommandExecuter::run_search ()
+{
+   while (1)
+   {
+      Move best_move;
+      IEngine::GameResult result = this->game_engine->get_best_move (SEARCH_DEPTH, board, best_move);
+
+      std::unique_lock<std::mutex> lock (this->search_mutex);
+
+      // A ponder search or an analysis that ran out of depth waits until it
+      // is cancelled or, if pondering, for the opponent's move
+      while ((this->search_state == PONDERING || this->search_state == ANALYZING) &&
+             !this->search_cancelled)
+      {
+         this->search_state_changed.wait (lock);
+      }
+
+      if (this->search_cancelled)
+         return;
+
+      this->search_state = IDLE;
+      play_move (result, best_move);
+      this->search_state_changed.notify_all ();
+
+      if (this->search_state != PONDERING)
+         return;
+   }
+}
+
+/*==============================================================================
+    Ask the engine to play the best move found so far, as in Xboard's '?'
+  ==============================================================================*/
+void
+UserCommandExecuter::move_now ()
+{
+   std::lock_guard<std::mutex> lock (this->search_mutex);
 
-   IEngine::GameResult result = this->game_engine->get_best_move (depth, board, best_move);
+   if (this->search_state == THINKING)
+      this->game_engine->stop ();
+}
+
+/*==============================================================================
+    Start analysing the current position in the background, without limit and
+    without making any move, until the analysis is cancelled.
+  ==============================================================================*/
+void
+UserCommandExecuter::analyze ()
+{
+   cancel_search ();
+
+   this->search_state = ANALYZING;
+   this->search_cancelled = false;
+
+   this->game_engine->start_infinite_search ();
+
+   this->search_thread = std::thread (&UserCommandExecuter::run_search, this);
+}
+
+/*==============================================================================
+    Stop the running search, if any, discarding its move, and wait for the
+    search thread to finish. If the engine was pondering, the expected reply
+    it was pondering on is taken back.
+  ==============================================================================*/
+void
+UserCommandExecuter::cancel_search ()
+{
+   if (!this->search_thread.joinable ())
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock (this->search_mutex);
+
+      this->search_cancelled = true;
+      this->game_engine->stop ();
+      this->search_state_changed.notify_all ();
+   }
 
+   this->search_thread.join ();
+
+   if (this->search_state == PONDERING)
+      this->board->undo_move ();
+
+   this->search_state = IDLE;
+   this->search_cancelled = false;
+}
+
+/*==============================================================================
+    Wait until the engine plays its move. Pondering, which only ends with the
+    opponent's move, is cancelled.
+  ==============================================================================*/
+void
+UserCommandExecuter::wait_for_search ()
+{
+   {
+      std::unique_lock<std::mutex> lock (this->search_mutex);
+
+      while (this->search_state == THINKING)
+         this->search_state_changed.wait (lock);
+   }
+
+   cancel_search ();
+}
+
+/*==============================================================================
+    Make BEST_MOVE, found by a search that ended with RESULT, and communicate
+    it to the GUI. Then start pondering, if enabled.
+  ==============================================================================*/
+void
+UserCommandExecuter::play_move (IEngine::GameResult result, Move best_move)
+{
    if (result == IEngine::NORMAL_EVALUATION ||
        result == IEngine::BLACK_MATES ||
        result == IEngine::WHITE_MATES)
@@ -221,6 +466,10 @@ UserCommandExecuter::think ()
       {
          cout << "0-1 {Black mates}" << std::endl;
       }
+      else if (error == IBoard::NO_ERROR && this->ponder_enabled)
+      {
+         start_pondering ();
+      }
    }
    else if (result == IEngine::STALEMATE)
    {
@@ -232,6 +481,87 @@ UserCommandExecuter::think ()
    }
 }
 
+/*==============================================================================
+    Turn on/off the report of search statistics. When on, the statistics of
+    every search are written to the standard error as a line of JSON, which
+    keeps them apart from the Xboard protocol messages, along with the
+    hardware events it caused where they can be counted.
+  ==============================================================================*/
+void
+UserCommandExecuter::toggle_statistics ()
+{
+   this->statistics_enabled = !this->statistics_enabled;
+   this->game_engine->set_statistics_output (this->statistics_enabled ? &cerr : nullptr);
+   this->game_engine->set_hardware_counting (this->statistics_enabled);
+}
+
+/*==============================================================================
+    Make the reply expected by the last search (the second move of its
+    principal variation), so that the search thread goes on searching the
+    resulting position until the opponent moves. The ponder search is deepened
+    without limit until either a ponder hit or a cancellation.
+
+    Called by the search thread with SEARCH_MUTEX held.
+  ==============================================================================*/
+void
+UserCommandExecuter::start_pondering ()
+{
+   vector<Move> principal_variation;
+   this->game_engine->get_principal_variation (principal_variation);
+
+   if (principal_variation.size () < 2)
+      return;
+
+   this->ponder_move = principal_variation[1];
+   if (this->board->make_move (this->ponder_move, true) != IBoard::NO_ERROR)
+      return;
+
+   this->game_engine->start_pondering ();
+   this->search_state = PONDERING;
+}
+
+void
+UserCommandExecuter::set_pondering (bool enabled)
+{
+   bool is_pondering;
+   {
+      std::lock_guard<std::mutex> lock (this->search_mutex);
+
+      this->ponder_enabled = enabled;
+      is_pondering = (this->search_state == PONDERING);
+   }
+
+   if (is_pondering && !enabled)
+      cancel_search ();
+}
+
+/*==============================================================================
+    Send the thinking output of the engine to Xboard, in the form
+    'ply score time nodes pv', with the time in centiseconds. Called from the
+    search thread; ANALYSIS_MODE is only changed while no search runs.
+  ==============================================================================*/
+void
+UserCommandExecuter::on_search_report (const game_engine::SearchReport& report)
+{
+   if (!this->post_enabled && !this->analysis_mode)
+      return;
+
+   // Xboard's convention for mate scores: 100000 + N for a mate in N moves,
+   // and -100000 - N for getting mated in N moves
+   int score = report.score;
+   if (report.is_mate)
+      score = score > 0 ? 100000 + score : -100000 + score;
+
+   std::ostringstream line;
+   line << report.depth << " " << score << " " << (ullong) (report.elapsed_ms / 10)
+        << " " << report.nodes;
+
+   for (uint i = 0; i < report.principal_variation.size (); ++i)
+      line << " " << report.principal_variation[i].get_notation ();
+
+   cout << line.str () << std::endl;
+}
+
 void
 UserCommandExecuter::train_by_genetic_algorithm (
     uint population_size, uint n_generations, double mutation_probability)
@@ -2,25 +2,38 @@
 #define USER_COMMAND_EXECUTER_H
 
 #include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include "Util.hpp"
+#include "IEngine.hpp"
+#include "ISearchObserver.hpp"
+#include "Move.hpp"
+#include "UserCommand.hpp"
 
 namespace game_rules { class IBoard; }
-namespace game_engine { class IEngine; class MoveGenerator; }
+namespace game_engine { class MoveGenerator; }
 namespace diagnostics { class Timer; }
 
 namespace game_ui
 {
-class UserCommand;
-
-class UserCommandExecuter
+class UserCommandExecuter : public game_engine::ISearchObserver
 {
   public:
    UserCommandExecuter (game_rules::IBoard*, game_engine::IEngine*, diagnostics::Timer*);
+   ~UserCommandExecuter ();
 
    bool execute (const UserCommand&);
    void show_possible_moves ();
    void make_user_move (const std::string& command);
    void think ();
+   void move_now ();
+   void analyze ();
+   void cancel_search ();
+   void wait_for_search ();
+   void toggle_statistics ();
+   void on_search_report (const game_engine::SearchReport& report);
    void train_by_genetic_algorithm (
        uint population_size, uint generations_count, double mutation_probability);
 
@@ -29,6 +42,44 @@ class UserCommandExecuter
    game_rules::IBoard* board;
    game_engine::IEngine* game_engine;
    game_engine::MoveGenerator* move_generator;
+
+   bool statistics_enabled;
+   bool force_mode;
+
+   // In analysis mode the engine searches the current position without limit
+   // and never moves. Thinking output is sent while analysing, and also while
+   // playing if POST_ENABLED
+   bool analysis_mode;
+   std::atomic<bool> post_enabled;
+
+   // Searches run on SEARCH_THREAD, so that commands can still be read while
+   // the engine thinks. SEARCH_MUTEX guards the members below, as well as
+   // every change made to the board by that thread
+   enum SearchState {
+      IDLE,
+      THINKING,
+      PONDERING,
+      ANALYZING
+   };
+
+   std::thread search_thread;
+   std::mutex search_mutex;
+   std::condition_variable search_state_changed;
+   SearchState search_state;
+   bool search_cancelled;
+
+   // While pondering, the board holds PONDER_MOVE, the reply the engine expects
+   bool ponder_enabled;
+   game_rules::Move ponder_move;
+
+   static const uint SEARCH_DEPTH = 3;
+
+   void run_search ();
+   void play_move (game_engine::IEngine::GameResult result, game_rules::Move best_move);
+   void start_pondering ();
+   void set_pondering (bool enabled);
+
+   static bool can_run_while_searching (UserCommand::CommandKey key);
 };
 
 } // game_ui
@@ -17,7 +17,9 @@ UserCommandReader::get_user_command ()
 {
    std::string command = "";
 
-   std::getline (std::cin, command);
+   // Behave as if the GUI quit if the input is closed
+   if (!std::getline (std::cin, command))
+      return UserCommand (UserCommand::QUIT);
 
    return UserCommand (command);
 }
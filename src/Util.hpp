@@ -1,6 +1,7 @@
 #ifndef UTIL_H
 #define UTIL_H
 
+#include <cassert>
 #include <climits>
 #include <vector>
 
@@ -8,6 +9,17 @@ typedef unsigned short int ushort;
 typedef unsigned int uint;
 typedef unsigned long long ullong;
 
+/*==============================================================================
+  Like assert, but EXPRESSION is still evaluated when assertions are compiled
+  out (NDEBUG), for the checks of calls made for their side effects, such as
+  VERIFY (board->undo_move ())
+  ==============================================================================*/
+#ifdef NDEBUG
+#define VERIFY(expression) ((void) (expression))
+#else
+#define VERIFY(expression) assert (expression)
+#endif
+
 namespace util
 {
 typedef unsigned long long bitboard;
@@ -34,11 +46,39 @@ class Util
    static void to_binary (ullong value);
 
    static int max (int a, int b) { return (a > b ? a : b); }
+   static int min (int a, int b) { return (a < b ? a : b); }
    static ushort bit (ushort n) { return 1 << n; }
 };
 
 bool is_odd(uint n);
 
+/*==============================================================================
+  The bit scans are at the heart of every move generation loop, so they are
+  defined here to be inlined, and use the instructions the compiler has for
+  them instead of a binary search. Both return -1 for an empty BITVECTOR.
+  ==============================================================================*/
+inline int
+Util::MSB_position (bitboard bitvector)
+{
+   if (bitvector == 0) return -1;
+
+   return 63 - __builtin_clzll (bitvector);
+}
+
+inline int
+Util::LSB_position (bitboard bitvector)
+{
+   if (bitvector == 0) return -1;
+
+   return __builtin_ctzll (bitvector);
+}
+
+inline uint
+Util::count_set_bits (bitboard bitvector)
+{
+   return __builtin_popcountll (bitvector);
+}
+
 } // namespace util
 
 #endif // UTIL_H
@@ -6,11 +6,16 @@
 #include "Timer.hpp"
 #include "UserCommandReader.hpp"
 #include "UserCommandExecuter.hpp"
+#include "UciCommandExecuter.hpp"
 #include "AlphaBetaSearch.hpp"
 #include "MoveGenerator.hpp"
 #include "PositionEvaluator.hpp"
+#include "Bench.hpp"
+#include "SearchTreeLog.hpp"
+#include "FenReader.hpp"
 
 using std::unique_ptr;
+using std::string;
 using std::cerr;
 using std::endl;
 
@@ -21,29 +26,83 @@ using game_rules::Move;
 
 using game_engine::IMoveGenerator;
 using game_engine::MoveGenerator;
-using game_engine::IPositionEvaluator;
 using game_engine::PositionEvaluator;
 using game_engine::IEngine;
 using game_engine::AlphaBetaSearch;
+using game_engine::SearchTreeLog;
+
+using game_persistence::FenReader;
 
 using game_ui::UserCommand;
 using game_ui::UserCommandReader;
 using game_ui::UserCommandExecuter;
+using game_ui::UciCommandExecuter;
 
 using diagnostics::Timer;
+using diagnostics::Bench;
+
+/*==============================================================================
+  Usage: mae [bench [depth]]
+         mae tree <file> <depth> <max ply> <max nodes> [fen]
 
+  Without arguments, play through the console (or a GUI). With 'bench',
+  search the positions of the benchmark to DEPTH and exit. With 'tree',
+  search FEN (the initial position by default) to DEPTH, logging its nodes
+  to FILE (see SearchTreeLog) and exit.
+  ==============================================================================*/
 int
-main ()
+main (int argc, char* argv[])
 {
   bool auto_play = false;
   bool xboard_mode = false;
 
   unique_ptr<IBoard> board(new MaeBoard());
-  unique_ptr<IPositionEvaluator> position_evaluator(new PositionEvaluator());
+  unique_ptr<PositionEvaluator> position_evaluator(new PositionEvaluator());
   unique_ptr<MoveGenerator> generator(new MoveGenerator());
   unique_ptr<IEngine> search_engine(
       new AlphaBetaSearch (position_evaluator.get(), generator.get()));
 
+  if (argc > 1 && string (argv[1]) == "bench")
+  {
+    uint depth = (argc > 2 ? std::stoul (argv[2]) : Bench::DEFAULT_DEPTH);
+
+    Bench bench (board.get (), search_engine.get ());
+    bench.run (depth, std::cout);
+
+    return 0;
+  }
+
+  if (argc > 5 && string (argv[1]) == "tree")
+  {
+    string fen = FenReader::INITIAL_POSITION;
+    if (argc > 6)
+    {
+      fen.clear ();
+      for (int i = 6; i < argc; ++i)
+        fen += string (argv[i]) + " ";
+    }
+
+    if (!board->load_fen (fen))
+    {
+      cerr << "Invalid position: " << fen << endl;
+      return 1;
+    }
+
+    SearchTreeLog tree_log (argv[2], std::stoul (argv[4]), std::stoull (argv[5]));
+    if (!tree_log.is_open ())
+    {
+      cerr << "Could not write to " << argv[2] << endl;
+      return 1;
+    }
+
+    Move best_move;
+    search_engine->set_tree_log (&tree_log);
+    search_engine->get_best_move (std::stoul (argv[3]), board.get (), best_move);
+    search_engine->set_tree_log (nullptr);
+
+    return 0;
+  }
+
   unique_ptr<Timer> timer(new Timer);
 
   UserCommand command;
@@ -62,6 +121,8 @@ main ()
     {
       Move move (command.get_notation ());
 
+      command_executer->cancel_search ();
+
       IBoard::Error error = board->make_move (move, false);
       if (error != IBoard::NO_ERROR)
       {
@@ -103,6 +164,17 @@ main ()
         auto_play = true;
         command_executer->execute (command);
       }
+      else if (command.get_key () == UserCommand::UCI_MODE)
+      {
+        // From now on, the GUI speaks UCI
+        command_executer->cancel_search ();
+
+        UciCommandExecuter uci_executer (board.get (), search_engine.get ());
+        while (uci_executer.execute (command.get_notation ()))
+          command = command_reader->get_user_command ();
+
+        break;
+      }
       else if (command.get_key () == UserCommand::COMPUTER_PLAY)
       {
         auto_play = !auto_play;
@@ -118,6 +190,10 @@ main ()
 
     if (!xboard_mode)
     {
+      // Searches run in the background, but the console shows the board
+      // after the engine's move
+      command_executer->wait_for_search ();
+
       cerr << (*board) << endl;
       cerr << (board->get_player_in_turn () == Piece::WHITE ?
                "[White's turn]: " : "[Black's turn]: ");
@@ -0,0 +1,191 @@
+/*==============================================================================
+  Usage: mae_tree <file> [count]
+
+  Summarize a search tree log written by 'mae tree' (see SearchTreeLog): how
+  the logged nodes spread over the plies, and the COUNT (20 by default)
+  heaviest subtrees, with the line that leads to each of them, so that
+  pruning and move ordering can be improved where the tree actually grows.
+  ==============================================================================*/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "SearchTreeLog.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::string;
+using std::vector;
+
+using game_engine::SearchTreeLog;
+
+typedef SearchTreeLog::NodeRecord NodeRecord;
+
+namespace
+{
+const int NO_PARENT = -1;
+
+/*------------------------------------------------------------------------------
+  Rebuild the tree from its post-order: the nodes still waiting for their
+  parent are kept in a stack, and a node adopts those of a greater ply
+  ----------------------------------------------------------------------------*/
+void
+find_parents (const vector<NodeRecord>& records, vector<int>& parent, vector<uint>& children)
+{
+   vector<int> pending;
+
+   parent.assign (records.size (), NO_PARENT);
+   children.assign (records.size (), 0);
+
+   for (uint i = 0; i < records.size (); ++i)
+   {
+      while (!pending.empty () && records[pending.back ()].ply > records[i].ply)
+      {
+         parent[pending.back ()] = i;
+         children[i]++;
+         pending.pop_back ();
+      }
+      pending.push_back (i);
+   }
+}
+
+string
+get_line (const vector<NodeRecord>& records, const vector<int>& parent, int node)
+{
+   vector<string> moves;
+
+   for (; node != NO_PARENT && records[node].kind != SearchTreeLog::ROOT; node = parent[node])
+      moves.push_back (SearchTreeLog::decode (records[node].move).get_notation ());
+
+   string line;
+   for (auto move = moves.rbegin (); move != moves.rend (); ++move)
+      line += (line.empty () ? "" : " ") + *move;
+
+   return line;
+}
+
+void
+print_plies (const vector<NodeRecord>& records)
+{
+   const uint MAX_PLY = SearchTreeLog::MAX_LOGGED_PLY + 1;
+   vector<ullong> nodes (MAX_PLY, 0), hits (MAX_PLY, 0), tt_cutoffs (MAX_PLY, 0);
+   vector<ullong> cutoffs (MAX_PLY, 0), first_move_cutoffs (MAX_PLY, 0);
+   uint deepest = 0;
+
+   for (const NodeRecord& record : records)
+   {
+      uint ply = record.ply;
+      deepest = std::max (deepest, ply);
+
+      nodes[ply]++;
+      hits[ply] += (record.transposition != SearchTreeLog::TT_MISS);
+      tt_cutoffs[ply] += (record.transposition == SearchTreeLog::TT_CUTOFF);
+      cutoffs[ply] += (record.cutoff_index != SearchTreeLog::NO_CUTOFF);
+      first_move_cutoffs[ply] += (record.cutoff_index == 0);
+   }
+
+   cout << setw (4) << "ply" << setw (12) << "nodes" << setw (10) << "tt hits"
+        << setw (12) << "tt cutoffs" << setw (10) << "cutoffs" << setw (14) << "first move %" << endl;
+
+   for (uint ply = 0; ply <= deepest; ++ply)
+      cout << setw (4) << ply << setw (12) << nodes[ply] << setw (10) << hits[ply]
+           << setw (12) << tt_cutoffs[ply] << setw (10) << cutoffs[ply]
+           << setw (14) << std::fixed << std::setprecision (1)
+           << (cutoffs[ply] ? 100.0 * first_move_cutoffs[ply] / cutoffs[ply] : 0.0) << endl;
+}
+
+void
+print_heaviest (const vector<NodeRecord>& records, uint count)
+{
+   const char* kinds[] = { "root", "full", "quiescence" };
+   const char* transpositions[] = { "miss", "hit", "cutoff" };
+
+   vector<int> parent;
+   vector<uint> children;
+   find_parents (records, parent, children);
+
+   // The root searches, in order, to tell which one each node belongs to
+   vector<uint> root_search (records.size (), 0);
+   uint root_searches = 0;
+   for (uint i = 0; i < records.size (); ++i)
+      if (records[i].kind == SearchTreeLog::ROOT)
+         root_search[i] = ++root_searches;
+
+   vector<uint> heaviest;
+   for (uint i = 0; i < records.size (); ++i)
+      if (records[i].kind != SearchTreeLog::ROOT)
+         heaviest.push_back (i);
+
+   count = std::min (count, (uint) heaviest.size ());
+   std::partial_sort (heaviest.begin (), heaviest.begin () + count, heaviest.end (),
+                      [&records] (uint a, uint b) { return records[a].nodes > records[b].nodes; });
+
+   cout << endl << "Heaviest subtrees:" << endl;
+   for (uint i = 0; i < count; ++i)
+   {
+      int node = heaviest[i];
+      int root = node;
+      while (parent[root] != NO_PARENT)
+         root = parent[root];
+
+      const NodeRecord& record = records[node];
+      cout << setw (10) << record.nodes << " nodes";
+      if (records[root].kind == SearchTreeLog::ROOT)
+         cout << " (" << std::fixed << std::setprecision (1)
+              << 100.0 * record.nodes / records[root].nodes << "% of root search "
+              << root_search[root] << ")";
+
+      cout << ", ply " << (uint) record.ply << " " << kinds[record.kind]
+           << ", window [" << record.alpha << ", " << record.beta << "]"
+           << ", value " << record.value
+           << ", tt " << transpositions[record.transposition]
+           << ", cutoff ";
+      if (record.cutoff_index == SearchTreeLog::NO_CUTOFF)
+         cout << "none";
+      else
+         cout << "at move " << (uint) record.cutoff_index;
+      cout << ", " << children[node] << " logged children" << endl
+           << "           " << get_line (records, parent, node) << endl;
+   }
+}
+}
+
+int
+main (int argc, char* argv[])
+{
+   if (argc < 2)
+   {
+      cerr << "Usage: " << argv[0] << " <file> [count]" << endl;
+      return 1;
+   }
+
+   vector<NodeRecord> records;
+   if (!SearchTreeLog::read (argv[1], records))
+   {
+      cerr << argv[1] << " is not a search tree log" << endl;
+      return 1;
+   }
+
+   uint count = (argc > 2 ? std::stoul (argv[2]) : 20);
+
+   ullong root_searches = 0, nodes = 0;
+   for (const NodeRecord& record : records)
+      if (record.kind == SearchTreeLog::ROOT)
+      {
+         root_searches++;
+         nodes += record.nodes;
+      }
+
+   cout << records.size () << " logged nodes, " << root_searches << " root searches visiting "
+        << nodes << " nodes" << endl << endl;
+
+   print_plies (records);
+   print_heaviest (records, count);
+
+   return 0;
+}
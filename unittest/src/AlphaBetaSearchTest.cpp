@@ -0,0 +1,41 @@
+#include "catch.hpp"
+#include "AlphaBetaSearch.hpp"
+
+namespace
+{
+using game_engine::IEngine;
+using game_engine::AlphaBetaSearch;
+
+const int MATE = IEngine::MATE_VALUE;
+const int DRAW = IEngine::DRAW_VALUE;
+
+TEST_CASE("Mate scores survive the transposition table", "[search][mate]") {
+   const uint plies[] = { 1, 2, 7, 30 };
+
+   for (uint ply : plies)
+      for (int distance = ply; distance <= (int) ply + 10; ++distance)
+      {
+         int mated = MATE + distance;     // Mated DISTANCE plies from the root
+         int mating = -MATE - distance;   // Mating in DISTANCE plies
+
+         REQUIRE(AlphaBetaSearch::from_table_score(AlphaBetaSearch::to_table_score(mated, ply), ply) == mated);
+         REQUIRE(AlphaBetaSearch::from_table_score(AlphaBetaSearch::to_table_score(mating, ply), ply) == mating);
+      }
+}
+
+TEST_CASE("Mate scores are stored as distances from the node", "[search][mate]") {
+   // Mated 5 plies from the root, found at ply 3: 2 plies from the node
+   REQUIRE(AlphaBetaSearch::to_table_score(MATE + 5, 3) == MATE + 2);
+   REQUIRE(AlphaBetaSearch::to_table_score(-MATE - 5, 3) == -MATE - 2);
+
+   // The same position found again 6 plies from the root
+   REQUIRE(AlphaBetaSearch::from_table_score(MATE + 2, 6) == MATE + 8);
+   REQUIRE(AlphaBetaSearch::from_table_score(-MATE - 2, 6) == -MATE - 8);
+
+   // Every other score is stored as it is
+   REQUIRE(AlphaBetaSearch::to_table_score(150, 4) == 150);
+   REQUIRE(AlphaBetaSearch::from_table_score(-150, 4) == -150);
+   REQUIRE(AlphaBetaSearch::to_table_score(DRAW, 9) == DRAW);
+}
+
+} // anonymous namespace
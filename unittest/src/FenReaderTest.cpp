@@ -0,0 +1,92 @@
+#include "catch.hpp"
+#include "FenReader.hpp"
+#include "MaeBoard.hpp"
+
+#include <string>
+
+namespace
+{
+using game_persistence::FenReader;
+using game_rules::MaeBoard;
+using game_rules::Piece;
+using game_rules::KING_SIDE;
+using game_rules::QUEEN_SIDE;
+
+// Read FEN into BOARD, as MaeBoard::load_fen does, but without resetting the
+// board on failure
+bool read_fen (const std::string& fen, MaeBoard& board)
+{
+   board.clear ();
+   FenReader reader (fen, &board);
+   return reader.set_position ();
+}
+
+TEST_CASE("Read valid FEN positions", "[fen]") {
+   MaeBoard board;
+
+   REQUIRE(read_fen(FenReader::INITIAL_POSITION, board));
+   REQUIRE(board.get_player_in_turn() == Piece::WHITE);
+   REQUIRE(board.get_piece(game_rules::e1) == Piece::KING);
+   REQUIRE(board.get_piece_color(game_rules::e1) == Piece::WHITE);
+   REQUIRE(board.get_piece(game_rules::a8) == Piece::ROOK);
+   REQUIRE(board.get_piece_color(game_rules::a8) == Piece::BLACK);
+   REQUIRE(board.get_state().can_do_castle[Piece::WHITE][KING_SIDE]);
+   REQUIRE(board.get_state().can_do_castle[Piece::BLACK][QUEEN_SIDE]);
+
+   // Kiwipete, with all four castling privileges
+   REQUIRE(read_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", board));
+
+   // Only some privileges, black to move, no move counters
+   REQUIRE(read_fen("r3k3/8/8/8/8/8/8/4K2R b Kq -", board));
+   REQUIRE(board.get_player_in_turn() == Piece::BLACK);
+   REQUIRE(board.get_state().can_do_castle[Piece::WHITE][KING_SIDE]);
+   REQUIRE_FALSE(board.get_state().can_do_castle[Piece::WHITE][QUEEN_SIDE]);
+   REQUIRE_FALSE(board.get_state().can_do_castle[Piece::BLACK][KING_SIDE]);
+   REQUIRE(board.get_state().can_do_castle[Piece::BLACK][QUEEN_SIDE]);
+
+   // An en-passant square that a pawn can actually capture on
+   REQUIRE(read_fen("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", board));
+   REQUIRE(board.get_en_passant_square() != 0);
+
+   // One no pawn can capture on is read, but not kept
+   REQUIRE(read_fen("4k3/8/8/3p4/8/8/8/4K3 w - d6 0 1", board));
+   REQUIRE(board.get_en_passant_square() == 0);
+}
+
+TEST_CASE("Reject malformed piece placements", "[fen]") {
+   MaeBoard board;
+
+   REQUIRE_FALSE(read_fen("", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR", board));    // No turn
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq -", board));    // 7 ranks
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/8/PPPPPPPP/RNBQKBNR w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/ppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - -", board)); // Short rank
+   REQUIRE_FALSE(read_fen("rnbqkbnr/ppppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN w - -", board)); // Last rank
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNRR w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR1 w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/88/8/8/8/PPPPPPPP/RNBQKBNR w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR/ w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp//8/8/8/PPPPPPPP/RNBQKBNR w - -", board));
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQXBNR w - -", board)); // Bad piece
+   REQUIRE_FALSE(read_fen("rnbq1bnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w - -", board)); // No king
+   REQUIRE_FALSE(read_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBKKBNR w - -", board)); // Two kings
+}
+
+TEST_CASE("Reject malformed turns, castling and en-passant fields", "[fen]") {
+   MaeBoard board;
+
+   REQUIRE_FALSE(read_fen("4k3/8/8/8/8/8/8/4K3 x - - 0 1", board));
+   REQUIRE_FALSE(read_fen("r3k2r/8/8/8/8/8/8/R3K2R w KQkx - 0 1", board));
+   REQUIRE_FALSE(read_fen("4k3/8/8/8/8/8/8/4K3 w - e9 0 1", board));
+   REQUIRE_FALSE(read_fen("4k3/8/8/8/8/8/8/4K3 w - e6 0 1", board)); // No pawn passed
+
+   // Privileges whose king or rook has left its initial square
+   REQUIRE_FALSE(read_fen("4k3/8/8/8/8/8/8/4K3 w K - 0 1", board));
+   REQUIRE_FALSE(read_fen("4k3/8/8/8/8/8/8/R4K2 w Q - 0 1", board));
+   REQUIRE_FALSE(read_fen("r3k3/8/8/8/8/8/8/4K3 w k - 0 1", board));
+   REQUIRE_FALSE(read_fen("1r2k3/8/8/8/8/8/8/4K3 w q - 0 1", board));
+   REQUIRE_FALSE(read_fen("R3k3/8/8/8/8/8/8/4K3 w q - 0 1", board));  // White rook
+}
+
+} // anonymous namespace
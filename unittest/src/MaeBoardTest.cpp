@@ -0,0 +1,193 @@
+#include "catch.hpp"
+#include "MaeBoard.hpp"
+#include "MoveGenerator.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+using game_engine::MoveGenerator;
+using game_rules::MaeBoard;
+using game_rules::Move;
+using game_rules::Piece;
+using game_rules::BoardSquare;
+using util::bitboard;
+
+/*==============================================================================
+  Play every legal move of the position in FEN, and check that gives_check
+  predicted whether it would leave the opponent in check. Return the number of
+  legal moves that give check.
+  ==============================================================================*/
+int check_gives_check (const std::string& fen)
+{
+   MaeBoard board;
+   MoveGenerator generator;
+   std::vector<Move> moves;
+   int checks = 0;
+
+   REQUIRE(board.load_fen(fen));
+   generator.generate_moves (&board, moves);
+
+   for (Move& move : moves)
+   {
+      bool gives_check = board.gives_check (move);
+      if (board.make_move (move, true) != MaeBoard::NO_ERROR)
+         continue;
+
+      INFO("FEN " << fen << ", move from " << move.from() << " to " << move.to());
+      CHECK(gives_check == board.is_king_in_check());
+
+      board.undo_move ();
+      if (gives_check)
+         ++checks;
+   }
+
+   return checks;
+}
+
+/*==============================================================================
+  Check that generate_quiet_checks gives, in the position in FEN, every legal
+  move that gives check without capturing or promoting, and no other legal
+  move. Return the number of such moves.
+  ==============================================================================*/
+int check_quiet_checks (const std::string& fen)
+{
+   MaeBoard board;
+   MoveGenerator generator;
+   std::vector<Move> moves, quiet_checks;
+   int expected_checks = 0;
+
+   REQUIRE(board.load_fen(fen));
+   generator.generate_moves (&board, moves);
+   generator.generate_quiet_checks (&board, quiet_checks);
+
+   for (Move& move : moves)
+   {
+      bool is_quiet = (board.get_piece (move.to ()) == game_rules::Piece::NULL_PIECE &&
+                       move.get_type () != Move::EN_PASSANT_CAPTURE &&
+                       move.get_type () != Move::PROMOTION_MOVE);
+
+      if (board.make_move (move, true) != MaeBoard::NO_ERROR)
+         continue;
+      bool is_check = board.is_king_in_check ();
+      board.undo_move ();
+
+      bool is_listed = (std::find (quiet_checks.begin (), quiet_checks.end (), move) !=
+                        quiet_checks.end ());
+
+      INFO("FEN " << fen << ", move from " << move.from() << " to " << move.to());
+      CHECK(is_listed == (is_quiet && is_check));
+      if (is_quiet && is_check)
+         ++expected_checks;
+   }
+
+   // Nor anything that is not a move of the position
+   for (Move& move : quiet_checks)
+      CHECK(std::find(moves.begin(), moves.end(), move) != moves.end());
+
+   return expected_checks;
+}
+
+/*==============================================================================
+  Check that the attack map BOARD holds, cached or not, is the one worked out
+  from scratch for the position in FEN
+  ==============================================================================*/
+void check_attack_map (const MaeBoard& board, const std::string& fen)
+{
+   MaeBoard expected_board;
+   REQUIRE(expected_board.load_fen(fen));
+
+   const MaeBoard::AttackMap& attack_map = board.get_attack_map ();
+   const MaeBoard::AttackMap& expected = expected_board.get_attack_map ();
+
+   INFO("FEN " << fen);
+   CHECK(attack_map.checkers == expected.checkers);
+   CHECK(attack_map.pinned == expected.pinned);
+   CHECK(attack_map.discovered_checkers == expected.discovered_checkers);
+   CHECK(board.is_king_in_check() == expected_board.is_king_in_check());
+
+   for (uint side = 0; side < game_rules::PLAYERS_COUNT; ++side)
+   {
+      CHECK(attack_map.attacked_by[side] == expected.attacked_by[side]);
+      for (uint type = 0; type < game_rules::PIECE_KINDS_COUNT; ++type)
+         CHECK(attack_map.attacked_by_piece[side][type] == expected.attacked_by_piece[side][type]);
+   }
+
+   for (uint type = 0; type < game_rules::PIECE_KINDS_COUNT; ++type)
+      CHECK(attack_map.check_squares[type] == expected.check_squares[type]);
+}
+
+bitboard bit (BoardSquare square)
+{
+   return util::Util::to_bitboard[square];
+}
+
+TEST_CASE("Predict checks in the perft reference positions", "[board][check]") {
+   REQUIRE(check_gives_check("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1") == 0);
+   REQUIRE(check_gives_check("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1") == 0);
+   REQUIRE(check_gives_check("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1") == 2);
+}
+
+TEST_CASE("Predict discovered checks by en-passant captures", "[board][check]") {
+   // Taking on c6 clears the fifth rank between the rook and the king
+   REQUIRE(check_gives_check("8/8/8/k1pP3R/8/8/8/4K3 w - c6 0 1") > 0);
+
+   // Taking on e3 clears the diagonal between the bishop and the king
+   REQUIRE(check_gives_check("1b2k3/8/8/8/4Pp2/8/7K/8 b - e3 0 1") > 0);
+}
+
+TEST_CASE("Predict checks given by the rook of a castle", "[board][check]") {
+   REQUIRE(check_gives_check("5k2/8/8/8/8/8/8/4K2R w K - 0 1") > 0);
+   REQUIRE(check_gives_check("r3k3/8/8/8/8/8/8/3K4 b q - 0 1") > 0);
+}
+
+TEST_CASE("Generate quiet checks only", "[board][check]") {
+   // Pushing g3 checks, while taking on f4 is left to the captures
+   REQUIRE(check_quiet_checks("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1") == 1);
+
+   // Castling checks; the rook can also check from f1 itself
+   REQUIRE(check_quiet_checks("5k2/8/8/8/8/8/8/4K2R w K - 0 1") >= 2);
+
+   // The queen checks from a4, a8 and h8, while the promotion on b8 is left out
+   REQUIRE(check_quiet_checks("4k3/1P6/4p3/8/8/8/8/Q3K3 w - - 0 1") == 3);
+   REQUIRE(check_quiet_checks("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1") == 0);
+}
+
+TEST_CASE("Keep the attack map up to date as the position changes", "[board][attacks]") {
+   // The bishop pins the knight, and the rook can check from h8
+   const std::string pin = "4k3/8/8/8/1b6/8/3N4/4K2R w K - 0 1";
+   const std::string rook_check = "4k2R/8/8/8/1b6/8/3N4/4K3 b - - 1 1";
+   const std::string two_pieces = "4k3/8/8/8/1b2r3/8/3N4/4K2R w K - 0 1";
+   const std::string double_check = "4k3/8/8/8/1b2r3/8/8/4K2R w K - 0 1";
+
+   MaeBoard board;
+   REQUIRE(board.load_fen(pin));
+   REQUIRE(board.get_attack_map().pinned == bit(game_rules::d2));
+   REQUIRE(board.get_attack_map().checkers == 0);
+   check_attack_map (board, pin);
+
+   Move move (game_rules::h1, game_rules::h8);
+   REQUIRE(board.make_move(move, true) == MaeBoard::NO_ERROR);
+   REQUIRE(board.get_attack_map().checkers == bit(game_rules::h8));
+   check_attack_map (board, rook_check);
+
+   REQUIRE(board.undo_move());
+   check_attack_map (board, pin);
+
+   REQUIRE(board.add_piece(game_rules::e4, Piece::ROOK, Piece::BLACK));
+   REQUIRE(board.get_attack_map().checkers == bit(game_rules::e4));
+   check_attack_map (board, two_pieces);
+
+   REQUIRE(board.remove_piece(game_rules::d2));
+   REQUIRE(board.get_attack_map().checkers == (bit(game_rules::b4) | bit(game_rules::e4)));
+   REQUIRE(board.get_attack_map().pinned == 0);
+   check_attack_map (board, double_check);
+
+   MaeBoard other_board;
+   REQUIRE(other_board.load_fen(rook_check));
+   board.set_state (other_board.get_state ());
+   check_attack_map (board, rook_check);
+}
+}
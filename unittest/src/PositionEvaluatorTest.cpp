@@ -0,0 +1,49 @@
+#include "catch.hpp"
+#include "MaeBoard.hpp"
+#include "PositionEvaluator.hpp"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using game_engine::PositionEvaluator;
+using game_rules::MaeBoard;
+
+TEST_CASE("Lazy evaluations fall on the same side of the window", "[evaluation]") {
+   const char* fens[] = {
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "4k3/8/8/8/8/8/8/QQQQKQQQ b - - 0 1",
+      "1k6/8/8/8/3N4/8/8/4K3 w - - 0 1"
+   };
+
+   // The default weights, and weights loaded apart from the material one
+   std::vector<std::vector<int>> all_weights = {
+      { 502, 780, 916, 22 }, { 1, 1000, 1000, 1000 }, { 10, -500, 700, -300 }
+   };
+
+   MaeBoard board;
+   for (std::vector<int>& weights : all_weights)
+   {
+      PositionEvaluator evaluator;
+      evaluator.load_factor_weights (weights);
+
+      for (const char* fen : fens)
+      {
+         REQUIRE(board.load_fen(fen));
+         int value = evaluator.static_evaluation (&board);
+
+         for (int alpha = value - 400000; alpha <= value + 400000; alpha += 997)
+         {
+            int beta = alpha + 1;
+            int lazy_value = evaluator.lazy_evaluation (&board, alpha, beta);
+
+            INFO("FEN " << fen << ", window " << alpha << ", weights " << weights[0]);
+            CHECK((lazy_value <= alpha) == (value <= alpha));
+            CHECK((lazy_value >= beta) == (value >= beta));
+         }
+      }
+   }
+}
+}
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+#include "Piece.hpp"
+#include "SearchLimits.hpp"
+
+namespace
+{
+using game_engine::SearchLimits;
+using game_rules::Piece;
+
+TEST_CASE("Spend the given move time, or none without a clock", "[limits][time]") {
+   SearchLimits limits;
+
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 0);
+
+   limits.increment[Piece::WHITE] = 2000;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 0);
+
+   limits.move_time = 500;
+   limits.set_clock(Piece::WHITE, 60000);
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 500);
+}
+
+TEST_CASE("Never search without a limit on an empty clock", "[limits][time]") {
+   SearchLimits limits;
+
+   // Only part of the increment is left to spend
+   limits.set_clock(Piece::WHITE, 0);
+   limits.increment[Piece::WHITE] = 100;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 50);
+
+   // And still some time without one
+   limits.increment[Piece::WHITE] = 0;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 1);
+
+   // Clocks gone below zero are empty
+   limits.set_clock(Piece::BLACK, -250);
+   REQUIRE(limits.has_clock[Piece::BLACK]);
+   REQUIRE(limits.time_left[Piece::BLACK] == 0);
+   REQUIRE(limits.get_move_time(Piece::BLACK) == 1);
+}
+
+TEST_CASE("Share the time left among the moves to go", "[limits][time]") {
+   SearchLimits limits;
+   limits.set_clock(Piece::WHITE, 60000);
+   limits.set_clock(Piece::BLACK, 30000);
+
+   // Sudden death: 30 moves assumed
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 2000);
+   REQUIRE(limits.get_move_time(Piece::BLACK) == 1000);
+
+   limits.moves_to_go = 10;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 6000);
+
+   // Most of the increment is spent too
+   limits.increment[Piece::WHITE] = 1000;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 6750);
+}
+
+TEST_CASE("Always keep a reserve on the clock", "[limits][time]") {
+   SearchLimits limits;
+   limits.set_clock(Piece::WHITE, 60000);
+
+   // The last move before the time control may not use up the clock
+   limits.moves_to_go = 1;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 54000);
+
+   // Nor may an increment larger than the time left
+   limits.moves_to_go = 0;
+   limits.set_clock(Piece::WHITE, 1000);
+   limits.increment[Piece::WHITE] = 5000;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 900);
+
+   // But some time is given however little is left
+   limits.set_clock(Piece::WHITE, 5);
+   limits.increment[Piece::WHITE] = 0;
+   REQUIRE(limits.get_move_time(Piece::WHITE) == 1);
+}
+}